@@ -0,0 +1,279 @@
+#ifndef AL_AHO_CORASICK_H
+#define AL_AHO_CORASICK_H
+
+/*
+ * Finds all occurrences of many patterns in a single pass over the text,
+ * instead of one boyer_moore_substring pass per pattern (Aho-Corasick).
+ *
+ * The patterns are built into a trie whose failure links are resolved
+ * into a complete DFA: every state has a transition for every input byte,
+ * so the scan is one table lookup per byte of text, no matter how many
+ * patterns there are.
+ *
+ * A dense DFA needs states * 256 transitions. To compress it, bytes that
+ * behave alike share a column: every byte occurring in some pattern gets a
+ * class of its own, all other bytes share class 0 (which always leads back
+ * to the root). A thousand English keywords have about 30 classes, so the
+ * table is 8 times smaller than the dense one.
+ *
+ * States where patterns end are chained by output links (the nearest
+ * proper suffix state where a pattern ends), so reporting k matches at a
+ * position takes O(k).
+ *
+ * References:
+ * - Aho, Corasick: Efficient string matching: an aid to bibliographic
+ *   search
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace al {
+
+class aho_corasick
+{
+  public:
+    typedef uint32_t state_type;
+
+    struct match
+    {
+      // offset of the first character of the occurrence in the text
+      size_t position;
+      // index of the pattern in the patterns given to the constructor
+      size_t pattern;
+
+      bool operator==(const match& other) const
+      {
+        return this->position == other.position &&
+          this->pattern == other.pattern;
+      }
+
+      bool operator<(const match& other) const
+      {
+        return this->position < other.position ||
+          (this->position == other.position && this->pattern < other.pattern);
+      }
+    };
+
+    // empty patterns never match
+    explicit aho_corasick(const std::vector<std::string>& patterns)
+    : byte_class(),
+      num_classes(1),
+      transitions(),
+      report_from(),
+      output_link(),
+      output_offsets(),
+      outputs(),
+      pattern_lengths()
+    {
+      this->assign_classes(patterns);
+      this->build_trie(patterns);
+      this->build_links();
+    }
+
+    // Calls func(match_begin, pattern) for every occurrence of every
+    // pattern, ordered by the position of their last character; occurrences
+    // ending at the same position from the longest pattern to the shortest.
+    template<typename function>
+    void find_all(const char * s_begin, const char * s_end, function func) const
+    {
+      const state_type * table = this->transitions.data();
+      const size_t classes = this->num_classes;
+
+      state_type state = 0;
+      for(const char * it = s_begin; it != s_end; ++it)
+      {
+        const unsigned char byte = static_cast<unsigned char>(*it);
+        state = table[state * classes + this->byte_class[byte]];
+
+        for(state_type out = this->report_from[state]; out != 0;
+            out = this->output_link[out])
+        {
+          for(size_t i = this->output_offsets[out];
+              i < this->output_offsets[out + 1];
+              ++i)
+          {
+            const size_t pattern = this->outputs[i];
+            func(it + 1 - this->pattern_lengths[pattern], pattern);
+          }
+        }
+      }
+    }
+
+    // every occurrence of every pattern, in the order of find_all
+    std::vector<match> find_all(const char * s_begin, const char * s_end) const
+    {
+      std::vector<match> matches;
+      this->find_all(s_begin, s_end,
+        [&matches, s_begin](const char * match_begin, size_t pattern) {
+          const match m = {
+            static_cast<size_t>(match_begin - s_begin), pattern
+          };
+          matches.push_back(m);
+        }
+      );
+
+      return matches;
+    }
+
+    size_t get_num_states() const
+    {
+      return this->report_from.size();
+    }
+
+    size_t get_num_classes() const
+    {
+      return this->num_classes;
+    }
+
+  private:
+    static const state_type no_state =
+      std::numeric_limits<state_type>::max();
+
+    // every byte of some pattern gets its own class
+    void assign_classes(const std::vector<std::string>& patterns)
+    {
+      this->byte_class.fill(0);
+      for(const auto& pattern : patterns)
+      {
+        for(auto c : pattern)
+        {
+          const unsigned char byte = static_cast<unsigned char>(c);
+          if( this->byte_class[byte] == 0 )
+            this->byte_class[byte] = static_cast<uint16_t>(this->num_classes++);
+        }
+      }
+    }
+
+    state_type add_state()
+    {
+      const state_type state = static_cast<state_type>(this->report_from.size());
+      this->transitions.resize(
+        this->transitions.size() + this->num_classes, state_type(no_state)
+      );
+      this->report_from.push_back(0);
+      this->output_link.push_back(0);
+
+      return state;
+    }
+
+    void build_trie(const std::vector<std::string>& patterns)
+    {
+      std::vector<std::vector<size_t>> ending;
+
+      this->add_state();
+      ending.emplace_back();
+
+      for(size_t index = 0; index < patterns.size(); ++index)
+      {
+        const std::string& pattern = patterns[index];
+        this->pattern_lengths.push_back(pattern.size());
+        if( pattern.empty() )
+          continue;
+
+        state_type state = 0;
+        for(auto c : pattern)
+        {
+          const size_t cell = state * this->num_classes +
+            this->byte_class[static_cast<unsigned char>(c)];
+
+          if( this->transitions[cell] == no_state )
+          {
+            const state_type next = this->add_state();
+            this->transitions[cell] = next;
+            ending.emplace_back();
+          }
+
+          state = this->transitions[cell];
+        }
+
+        ending[state].push_back(index);
+      }
+
+      // the patterns ending in each state, flattened
+      this->output_offsets.push_back(0);
+      for(const auto& patterns_of_state : ending)
+      {
+        this->outputs.insert(
+          this->outputs.end(), patterns_of_state.begin(), patterns_of_state.end()
+        );
+        this->output_offsets.push_back(this->outputs.size());
+      }
+    }
+
+    bool has_outputs(state_type state) const
+    {
+      return this->output_offsets[state + 1] > this->output_offsets[state];
+    }
+
+    // breadth first, so the failure state of a state is complete before
+    // the state itself
+    void build_links()
+    {
+      const size_t classes = this->num_classes;
+      std::vector<state_type> fail(this->report_from.size(), 0);
+      std::queue<state_type> pending;
+
+      for(size_t c = 0; c < classes; ++c)
+      {
+        state_type& next = this->transitions[c];
+        if( next == no_state )
+          next = 0;
+        else
+          pending.push(next);
+      }
+
+      while( !pending.empty() )
+      {
+        const state_type state = pending.front();
+        pending.pop();
+
+        const state_type f = fail[state];
+        this->output_link[state] =
+          this->has_outputs(f) ? f : this->output_link[f];
+        this->report_from[state] =
+          this->has_outputs(state) ? state : this->output_link[state];
+
+        for(size_t c = 0; c < classes; ++c)
+        {
+          state_type& next = this->transitions[state * classes + c];
+          const state_type fail_next = this->transitions[f * classes + c];
+
+          if( next == no_state )
+          {
+            next = fail_next;
+          }
+          else
+          {
+            fail[next] = fail_next;
+            pending.push(next);
+          }
+        }
+      }
+    }
+
+    std::array<uint16_t, 256> byte_class;
+    size_t num_classes;
+    // num_states x num_classes
+    std::vector<state_type> transitions;
+    // the first state with outputs on the output chain of a state, 0: none
+    std::vector<state_type> report_from;
+    // the next state with outputs on the chain, 0: end
+    std::vector<state_type> output_link;
+    // the patterns ending in state s are
+    // outputs[output_offsets[s]..output_offsets[s + 1])
+    std::vector<size_t> output_offsets;
+    std::vector<size_t> outputs;
+    std::vector<size_t> pattern_lengths;
+};
+
+}
+
+#endif // AL_AHO_CORASICK_H
@@ -0,0 +1,39 @@
+#ifndef AL_BLOCKED_MATRIX_MULTIPLY_H
+#define AL_BLOCKED_MATRIX_MULTIPLY_H
+
+#include <stdexcept>
+
+#include "al/mm/blocked-kernel.h"
+
+namespace al {
+
+// classical O(n^3) matrix multiplication, cache blocked and register tiled;
+// see al/mm/blocked-kernel.h
+template<typename square_matrix>
+square_matrix blocked_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right
+)
+{
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "blocked matrix multiply impossible");
+  }
+
+  const size_t width = left.get_width();
+  square_matrix result(width);
+
+  mm::blocked_multiply_add(
+    width, width, width,
+    left.raw_data(), width,
+    right.raw_data(), width,
+    result.raw_data(), width
+  );
+
+  return result;
+}
+
+}
+
+#endif // AL_BLOCKED_MATRIX_MULTIPLY_H
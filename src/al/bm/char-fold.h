@@ -0,0 +1,76 @@
+#ifndef AL_BM_CHAR_FOLD_H
+#define AL_BM_CHAR_FOLD_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace al {
+namespace bm {
+
+// characters match only themselves
+struct identity_fold
+{
+  template<typename char_type>
+  char_type operator()(char_type c) const
+  {
+    return c;
+  }
+};
+
+// Bytes are mapped through a table; bytes mapped to the same value match
+// each other (byte classes). Starts as the identity.
+class byte_fold
+{
+  public:
+    byte_fold()
+    : table()
+    {
+      for(size_t i = 0; i < this->table.size(); ++i)
+        this->table[i] = static_cast<unsigned char>(i);
+    }
+
+    // merges the classes of from and to: afterwards every byte that
+    // matched from matches every byte that matched to
+    void map(unsigned char from, unsigned char to)
+    {
+      const unsigned char old_class = this->table[from];
+      const unsigned char new_class = this->table[to];
+
+      for(auto& entry : this->table)
+        if( entry == old_class )
+          entry = new_class;
+    }
+
+    template<typename char_type>
+    char_type operator()(char_type c) const
+    {
+      static_assert(
+        sizeof(char_type) == 1,
+        "byte_fold only folds single byte characters"
+      );
+      return static_cast<char_type>(
+        this->table[static_cast<unsigned char>(c)]
+      );
+    }
+
+  private:
+    std::array<unsigned char, 256> table;
+};
+
+// ASCII letters match regardless of case; all other bytes only themselves
+class ascii_case_fold : public byte_fold
+{
+  public:
+    ascii_case_fold()
+    : byte_fold()
+    {
+      for(unsigned char c = 'A'; c <= 'Z'; ++c)
+        this->map(c, static_cast<unsigned char>(c - 'A' + 'a'));
+    }
+};
+
+}
+}
+
+#endif // AL_BM_CHAR_FOLD_H
@@ -0,0 +1,76 @@
+#ifndef AL_BM_COMPACT_SKIP_TABLE_H
+#define AL_BM_COMPACT_SKIP_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace al {
+namespace bm {
+
+// A static skip table with small entries: for char and uint8_t entries it
+// is 256 bytes (4 cache lines) instead of the 2 KiB of a static_skip_table
+// of ptrdiff_t.
+//
+// The values must be shifts, where a smaller value is always safe: values
+// above the maximum of entry_type are stored as that maximum. uint8_t
+// entries are exact for patterns of up to 254 characters, uint16_t entries
+// for up to 65534; longer patterns only get shorter shifts.
+template<
+  typename key_type,
+  typename value_type,
+  typename entry_type = uint8_t
+>
+class compact_skip_table
+{
+  public:
+    compact_skip_table(
+      size_t, // pattern_len; preserve common skip table interface
+      value_type default_value
+    )
+    : table()
+    {
+      this->table.fill(clamp(default_value));
+    }
+
+    value_type get(key_type idx) const
+    {
+      return static_cast<value_type>(this->table[index_of(idx)]);
+    }
+
+    void set(key_type idx, value_type val)
+    {
+      this->table[index_of(idx)] = clamp(val);
+    }
+
+  private:
+    static_assert(
+      std::is_unsigned<entry_type>::value,
+      "skip table entries are unsigned"
+    );
+
+    // negative (signed) chars index the upper half of the table
+    static size_t index_of(key_type idx)
+    {
+      return static_cast<typename std::make_unsigned<key_type>::type>(idx);
+    }
+
+    static entry_type clamp(value_type val)
+    {
+      const entry_type max_entry = std::numeric_limits<entry_type>::max();
+      return val > static_cast<value_type>(max_entry) ?
+        max_entry : static_cast<entry_type>(val);
+    }
+
+    std::array<
+      entry_type,
+      1U << (std::numeric_limits<unsigned char>::digits * sizeof(key_type))
+    > table;
+};
+
+}
+}
+
+#endif // AL_BM_COMPACT_SKIP_TABLE_H
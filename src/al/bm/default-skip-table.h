@@ -0,0 +1,38 @@
+#ifndef AL_BM_DEFAULT_SKIP_TABLE_H
+#define AL_BM_DEFAULT_SKIP_TABLE_H
+
+#include <type_traits>
+
+#include "compact-skip-table.h"
+#include "dynamic-skip-table.h"
+#include "flat-skip-table.h"
+
+namespace al {
+namespace bm {
+
+// choose a compact skip table (std::array of uint8_t) for small alphabets
+// (e.g. char)
+// choose a flat skip table (open addressing) for wide integral characters
+// (e.g. wchar_t, char32_t)
+// choose a dynamic skip table (std::unordered_map) for everything else
+template<
+  typename char_type,
+  typename diff_type
+>
+struct default_skip_table
+{
+  typedef typename std::conditional<
+    std::is_integral<char_type>::value && sizeof(char_type) < 2,
+    compact_skip_table<char_type, diff_type>,
+    typename std::conditional<
+      std::is_integral<char_type>::value,
+      flat_skip_table<char_type, diff_type>,
+      dynamic_skip_table<char_type, diff_type>
+    >::type
+  >::type type;
+};
+
+}
+}
+
+#endif // AL_BM_DEFAULT_SKIP_TABLE_H
@@ -34,7 +34,7 @@ class dynamic_skip_table
     }
 
   private:
-    const value_type default_value;
+    value_type default_value;
     std::unordered_map<key_type, value_type> table;
 };
 
@@ -0,0 +1,114 @@
+#ifndef AL_BM_FLAT_SKIP_TABLE_H
+#define AL_BM_FLAT_SKIP_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace al {
+namespace bm {
+
+// A skip table for wide integral characters (wchar_t, char32_t, ...), too
+// many for a static table: an open addressing hash table with linear
+// probing in a single array.
+//
+// It holds at most one key per pattern character and at least four times
+// as many slots, so a lookup of a character not in the pattern (the common
+// case) usually stops at its first, empty slot: one multiplication and one
+// cache line, no allocation and no pointer chase as in dynamic_skip_table.
+template<
+  typename key_type,
+  typename value_type
+>
+class flat_skip_table
+{
+  public:
+    flat_skip_table(size_t pattern_len, value_type default_val)
+    : default_value(default_val),
+      shift(64),
+      mask(0),
+      slots()
+    {
+      size_t capacity = 16;
+      this->shift -= 4;
+      while( capacity < 4 * pattern_len )
+      {
+        capacity *= 2;
+        --this->shift;
+      }
+
+      this->mask = capacity - 1;
+      this->slots.resize(capacity);
+    }
+
+    value_type get(key_type idx) const
+    {
+      for(size_t i = this->home_of(idx); ; i = (i + 1) & this->mask)
+      {
+        const slot& s = this->slots[i];
+        if( !s.used )
+          return this->default_value;
+        if( s.key == idx )
+          return s.value;
+      }
+    }
+
+    // at most pattern_len distinct keys may be set
+    void set(key_type idx, value_type val)
+    {
+      for(size_t i = this->home_of(idx); ; i = (i + 1) & this->mask)
+      {
+        slot& s = this->slots[i];
+        if( !s.used || s.key == idx )
+        {
+          s.key = idx;
+          s.value = val;
+          s.used = true;
+          return;
+        }
+      }
+    }
+
+  private:
+    static_assert(
+      std::is_integral<key_type>::value,
+      "flat_skip_table needs integral characters"
+    );
+
+    struct slot
+    {
+      slot()
+      : key(),
+        value(),
+        used(false)
+      {
+      }
+
+      key_type key;
+      value_type value;
+      bool used;
+    };
+
+    // Fibonacci hashing: the high bits of the product, so characters of
+    // one script (close code points) spread over the table
+    size_t home_of(key_type idx) const
+    {
+      const uint64_t key = static_cast<uint64_t>(
+        static_cast<typename std::make_unsigned<key_type>::type>(idx)
+      );
+      return static_cast<size_t>(
+        (key * UINT64_C(0x9e3779b97f4a7c15)) >> this->shift
+      );
+    }
+
+    value_type default_value;
+    unsigned int shift;
+    size_t mask;
+    std::vector<slot> slots;
+};
+
+}
+}
+
+#endif // AL_BM_FLAT_SKIP_TABLE_H
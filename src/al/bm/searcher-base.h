@@ -0,0 +1,117 @@
+#ifndef AL_BM_SEARCHER_BASE_H
+#define AL_BM_SEARCHER_BASE_H
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace al {
+namespace bm {
+
+// The search interface shared by the single pattern searchers (CRTP).
+// derived_type only provides
+//
+//   template<typename s_iter, typename function>
+//   void scan(s_iter s_begin, s_iter s_end, function on_match) const;
+//
+// which calls on_match(match) for every occurrence of the pattern, in
+// order, until it returns true. scan is only called for a non-empty
+// pattern.
+template<
+  typename derived_type,
+  typename p_diff_type,
+  typename p_char_type
+>
+class searcher_base
+{
+  public:
+    template<
+      typename s_iter,
+      typename = typename std::enable_if<
+        std::is_same<
+          typename std::iterator_traits<s_iter>::value_type,
+          p_char_type
+        >::value
+      >::type
+    >
+    s_iter strstr(s_iter s_begin, s_iter s_end) const
+    {
+      if( this->pattern_len < 1 )
+        return s_begin;
+
+      s_iter found = s_end;
+      this->derived().scan(s_begin, s_end, [&found](s_iter match) {
+        found = match;
+        return true;
+      });
+
+      return found;
+    }
+
+    // Calls func(match) with an iterator to every occurrence of the pattern,
+    // overlapping ones included, in order. An empty pattern has none.
+    template<
+      typename s_iter,
+      typename function,
+      typename = typename std::enable_if<
+        std::is_same<
+          typename std::iterator_traits<s_iter>::value_type,
+          p_char_type
+        >::value
+      >::type
+    >
+    void find_all(s_iter s_begin, s_iter s_end, function func) const
+    {
+      if( this->pattern_len < 1 )
+        return;
+
+      this->derived().scan(s_begin, s_end, [&func](s_iter match) {
+        func(match);
+        return false;
+      });
+    }
+
+    // iterators to every occurrence of the pattern
+    template<
+      typename s_iter,
+      typename = typename std::enable_if<
+        std::is_same<
+          typename std::iterator_traits<s_iter>::value_type,
+          p_char_type
+        >::value
+      >::type
+    >
+    std::vector<s_iter> find_all(s_iter s_begin, s_iter s_end) const
+    {
+      std::vector<s_iter> matches;
+      this->find_all(s_begin, s_end, [&matches](s_iter match) {
+        matches.push_back(match);
+      });
+
+      return matches;
+    }
+
+    p_diff_type get_pattern_length() const
+    {
+      return this->pattern_len;
+    }
+
+  protected:
+    explicit searcher_base(p_diff_type pattern_length)
+    : pattern_len(pattern_length)
+    {
+    }
+
+    const p_diff_type pattern_len;
+
+  private:
+    const derived_type& derived() const
+    {
+      return static_cast<const derived_type&>(*this);
+    }
+};
+
+}
+}
+
+#endif // AL_BM_SEARCHER_BASE_H
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <limits>
+#include <type_traits>
 
 namespace al { 
 namespace bm {
@@ -25,15 +26,21 @@ class static_skip_table
 
     value_type get(key_type idx) const
     {
-      return this->table.at(idx);
+      return this->table[index_of(idx)];
     }
 
     void set(key_type idx, value_type val)
     {
-      this->table.at(idx) = val;
+      this->table[index_of(idx)] = val;
     }
 
   private:
+    // negative (signed) chars index the upper half of the table
+    static size_t index_of(key_type idx)
+    {
+      return static_cast<typename std::make_unsigned<key_type>::type>(idx);
+    }
+
     std::array<
       value_type, 
       1U << (std::numeric_limits<unsigned char>::digits * sizeof(key_type))
@@ -5,13 +5,31 @@
 // http://stackoverflow.com/questions/19345263/boyer-moore-good-suffix-heuristics#19440319/
 // http://www.iti.fh-flensburg.de/lang/algorithmen/pattern/bmen.htm
 
+// Characters are compared after mapping them through fold_type, e.g.
+// bm::ascii_case_fold for case-insensitive search. The pattern is folded
+// once, into a copy the skip table and the suffix table are built over; the
+// text is folded while it is searched, one table lookup per compared
+// character, instead of being copied.
+
+// The searcher owns a copy of the pattern, so it may outlive the pattern it
+// was built from, and be copied or moved, e.g. into a cache of prebuilt
+// searchers. Searching does not modify it, so one searcher may be used by
+// many threads at once. save and load store a searcher in a stream.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
 #include <iterator>
-#include <vector>
-#include <type_traits>
 #include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
-#include "bm/static-skip-table.h"
-#include "bm/dynamic-skip-table.h"
+#include "bm/char-fold.h"
+#include "bm/default-skip-table.h"
 
 namespace al
 {
@@ -20,26 +38,82 @@ template<
   typename p_iter,
   typename p_diff_type = typename std::iterator_traits<p_iter>::difference_type, 
   typename p_char_type = typename std::iterator_traits<p_iter>::value_type,
-  // choose a static skip table (std::array) for small alphabets (e.g. char)
-  // choose a dynamic skip table (std::unordered_map) for everything else
-  typename table_type = typename std::conditional<
-    std::is_integral<p_char_type>::value && sizeof(p_char_type) < 2,
-    bm::static_skip_table<p_char_type, p_diff_type>,
-    bm::dynamic_skip_table<p_char_type, p_diff_type>
-  >::type
+  typename table_type =
+    typename bm::default_skip_table<p_char_type, p_diff_type>::type,
+  typename fold_type = bm::identity_fold
 >
 class boyer_moore_substring
 {
   public:
-    boyer_moore_substring(p_iter begin, p_iter end)
-    : p_begin(begin),
-      p_end(end),
-      pattern_len(std::distance(begin, end)),
-      skip(this->pattern_len, -1),
-      suffix(this->pattern_len + 1U)
+    boyer_moore_substring(
+      p_iter begin,
+      p_iter end,
+      const fold_type& char_fold = fold_type()
+    )
+    : boyer_moore_substring(std::vector<p_char_type>(begin, end), char_fold)
     {
-      this->fill_skip(begin, end);
-      this->fill_suffix(begin, end);
+    }
+
+    // Writes the pattern to out, in the byte order of this machine. Only
+    // the pattern is written, load rebuilds the tables: that is as fast as
+    // reading them, and a damaged file cannot make the (unchecked) table
+    // lookups of the search read out of bounds.
+    void save(std::ostream& out) const
+    {
+      static_assert(
+        std::is_trivially_copyable<p_char_type>::value,
+        "only patterns of trivially copyable characters can be saved"
+      );
+
+      const uint32_t header[] = {
+        file_magic, file_version, static_cast<uint32_t>(sizeof(p_char_type))
+      };
+      const uint64_t length = static_cast<uint64_t>(this->pattern.size());
+
+      out.write(reinterpret_cast<const char *>(header), sizeof(header));
+      out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+      out.write(
+        reinterpret_cast<const char *>(this->pattern.data()),
+        static_cast<std::streamsize>(this->pattern.size() * sizeof(p_char_type))
+      );
+    }
+
+    // Reads a searcher written by save; throws std::runtime_error if in
+    // does not hold one for this character type. The fold is not saved.
+    static boyer_moore_substring load(
+      std::istream& in,
+      const fold_type& char_fold = fold_type()
+    )
+    {
+      uint32_t header[3];
+      uint64_t length = 0;
+      in.read(reinterpret_cast<char *>(header), sizeof(header));
+      in.read(reinterpret_cast<char *>(&length), sizeof(length));
+
+      if( !in || header[0] != file_magic || header[1] != file_version ||
+          header[2] != sizeof(p_char_type) )
+        throw std::runtime_error("no boyer_moore_substring pattern in stream");
+
+      // in chunks, so a wrong length fails at the end of the stream
+      // instead of allocating all of it
+      std::vector<p_char_type> chars;
+      while( chars.size() < length )
+      {
+        const size_t offset = chars.size();
+        const size_t count = static_cast<size_t>(
+          std::min<uint64_t>(length - offset, 1 << 16)
+        );
+        chars.resize(offset + count);
+        in.read(
+          reinterpret_cast<char *>(chars.data() + offset),
+          static_cast<std::streamsize>(count * sizeof(p_char_type))
+        );
+
+        if( !in )
+          throw std::runtime_error("boyer_moore_substring pattern truncated");
+      }
+
+      return boyer_moore_substring(std::move(chars), char_fold);
     }
 
     template<
@@ -64,59 +138,159 @@ class boyer_moore_substring
       if( this->pattern_len < 1 )
         return s_begin;
 
+      return this->find_from(s_begin, s_end);
+    }
+
+    // Calls func(match) with an iterator to every occurrence of the pattern,
+    // overlapping ones included, in order. An empty pattern has none.
+    template<
+      typename s_iter,
+      typename function,
+      typename = typename std::enable_if<
+        std::is_same<
+          typename std::iterator_traits<s_iter>::value_type,
+          p_char_type
+        >::value
+      >::type
+    >
+    void find_all(s_iter s_begin, s_iter s_end, function func) const
+    {
+      if( this->pattern_len < 1 )
+        return;
+
       s_iter current = s_begin;
+      while( std::distance(current, s_end) >= this->pattern_len )
+      {
+        current = this->find_from(current, s_end);
+        if( current == s_end )
+          return;
+
+        func(current);
+
+        // the shortest shift for which the pattern may overlap itself
+        current += this->suffix[0];
+      }
+    }
+
+    // iterators to every occurrence of the pattern
+    template<
+      typename s_iter,
+      typename = typename std::enable_if<
+        std::is_same<
+          typename std::iterator_traits<s_iter>::value_type,
+          p_char_type
+        >::value
+      >::type
+    >
+    std::vector<s_iter> find_all(s_iter s_begin, s_iter s_end) const
+    {
+      std::vector<s_iter> matches;
+      this->find_all(s_begin, s_end, [&matches](s_iter match) {
+        matches.push_back(match);
+      });
+
+      return matches;
+    }
+
+    p_diff_type get_pattern_length() const
+    {
+      return this->pattern_len;
+    }
+
+    const std::vector<p_char_type>& get_pattern() const
+    {
+      return this->pattern;
+    }
+
+  private:
+    // "ALBM"
+    static const uint32_t file_magic = 0x4d424c41;
+    static const uint32_t file_version = 1;
+
+    std::vector<p_char_type> pattern;
+    p_diff_type pattern_len;
+    fold_type fold;
+    // the pattern mapped through fold, which the search compares against
+    std::vector<p_char_type> folded;
+    table_type skip;
+    std::vector<p_diff_type> suffix;
+
+    boyer_moore_substring(
+      std::vector<p_char_type>&& chars,
+      const fold_type& char_fold
+    )
+    : pattern(std::move(chars)),
+      pattern_len(static_cast<p_diff_type>(this->pattern.size())),
+      fold(char_fold),
+      folded(this->pattern),
+      skip(this->pattern_len, this->pattern_len),
+      suffix(this->pattern_len + 1U)
+    {
+      for(auto& c : this->folded)
+        c = this->fold(c);
+
+      this->fill_skip(this->folded.begin(), this->folded.end());
+      this->fill_suffix(this->folded.begin(), this->folded.end());
+    }
+
+    // the first occurrence at or after current, s_end if there is none;
+    // at least pattern_len > 0 characters must be left
+    template<typename s_iter>
+    s_iter find_from(s_iter current, s_iter s_end) const
+    {
+      typedef typename std::iterator_traits<s_iter>::difference_type s_diff_type;
+
+      const p_char_type * p = this->folded.data();
       s_iter last = s_end - this->pattern_len;
       s_diff_type j, k, m;
 
       while( current <= last )
       {
         j = this->pattern_len;
-        while( this->p_begin[j - 1] == current[j - 1] )
+        while( p[j - 1] == this->fold(current[j - 1]) )
         {
           --j;
           if( j == 0 )
             return current;
         }
 
-        k = this->skip.get(current[j - 1]);
+        k = this->pattern_len - 1 - this->skip.get(this->fold(current[j - 1]));
         m = j - k - 1;
-        if( k < j && m > this->suffix.at(j) )
+        if( k < j && m > this->suffix[j] )
         {
           current += m;
         }
         else
         {
-          current += this->suffix.at(j);
+          current += this->suffix[j];
         }
       }
       return s_end;
     }
 
-  private:
-    const p_iter p_begin;
-    const p_iter p_end;
-    const p_diff_type pattern_len;
-    table_type skip;
-    std::vector<p_diff_type> suffix;
-
-    void fill_skip(p_iter begin, p_iter end)
+    // the distance of the last occurrence of each character to the end of
+    // the folded pattern, pattern_len if it does not occur; tables may
+    // store less
+    template<typename iter>
+    void fill_skip(iter begin, iter end)
     {
       p_diff_type i = 0;
       while( begin != end )
       {
-        this->skip.set(*begin, i++);
+        this->skip.set(*begin, this->pattern_len - 1 - i++);
         ++begin;
       }
     }
 
-    void fill_suffix(p_iter begin, p_iter end)
+    template<typename iter>
+    void fill_suffix(iter begin, iter end)
     {
       if( this->pattern_len )
       {
         auto prefix = this->get_prefix(begin, end);
         auto reversed_prefix = this->get_prefix(
-          std::reverse_iterator<p_iter>(end),
-          std::reverse_iterator<p_iter>(begin)
+          std::reverse_iterator<iter>(end),
+          std::reverse_iterator<iter>(begin)
         );
 
         for(p_diff_type i = 0; i <= this->pattern_len; ++i)
@@ -142,10 +316,10 @@ class boyer_moore_substring
       prefix.at(0) = 0;
       for(p_diff_type i = 1; i < this->pattern_len; ++i)
       {
-        while( j > 0 && (begin + j != begin + i) )
+        while( j > 0 && begin[j] != begin[i] )
           j = prefix.at(j - 1);
 
-        if( begin + j == begin + i )
+        if( begin[j] == begin[i] )
           ++j;
 
         prefix.at(i) = j;
@@ -0,0 +1,84 @@
+#ifndef AL_HORSPOOL_SUBSTRING_H
+#define AL_HORSPOOL_SUBSTRING_H
+
+// Boyer-Moore-Horspool: Boyer-Moore without the good suffix rule. The
+// window is shifted by the bad character rule for the last character of
+// the window only, so the setup is a single pass over the pattern.
+//
+// http://www.iti.fh-flensburg.de/lang/algorithmen/pattern/horsen.htm
+
+#include <algorithm>
+#include <iterator>
+
+#include "bm/default-skip-table.h"
+#include "bm/searcher-base.h"
+
+namespace al
+{
+
+template<
+  typename p_iter,
+  typename p_diff_type = typename std::iterator_traits<p_iter>::difference_type,
+  typename p_char_type = typename std::iterator_traits<p_iter>::value_type,
+  typename table_type =
+    typename bm::default_skip_table<p_char_type, p_diff_type>::type
+>
+class horspool_substring
+: public bm::searcher_base<
+    horspool_substring<p_iter, p_diff_type, p_char_type, table_type>,
+    p_diff_type,
+    p_char_type
+  >
+{
+  public:
+    horspool_substring(p_iter begin, p_iter end)
+    : searcher_base(std::distance(begin, end)),
+      p_begin(begin),
+      skip(this->pattern_len, this->pattern_len)
+    {
+      // the distance of the last occurrence of each character (but the
+      // last one) to the end of the pattern
+      p_diff_type i = 0;
+      for(p_iter it = begin; i + 1 < this->pattern_len; ++it, ++i)
+        this->skip.set(*it, this->pattern_len - 1 - i);
+    }
+
+  private:
+    typedef bm::searcher_base<
+      horspool_substring, p_diff_type, p_char_type
+    > searcher_base;
+    friend searcher_base;
+
+    const p_iter p_begin;
+    table_type skip;
+
+    // on_match(match) for every occurrence until it returns true;
+    // the pattern is not empty
+    template<typename s_iter, typename function>
+    void scan(s_iter s_begin, s_iter s_end, function on_match) const
+    {
+      if( std::distance(s_begin, s_end) < this->pattern_len )
+        return;
+
+      const p_diff_type last_index = this->pattern_len - 1;
+      const p_char_type last_char = this->p_begin[last_index];
+
+      s_iter current = s_begin;
+      s_iter last = s_end - this->pattern_len;
+
+      while( current <= last )
+      {
+        const p_char_type c = current[last_index];
+        if( c == last_char &&
+            std::equal(this->p_begin, this->p_begin + last_index, current) &&
+            on_match(current) )
+          return;
+
+        current += this->skip.get(c);
+      }
+    }
+};
+
+}
+
+#endif // AL_HORSPOOL_SUBSTRING_H
@@ -0,0 +1,260 @@
+#ifndef AL_MATRIX_CHAIN_MULTIPLY_H
+#define AL_MATRIX_CHAIN_MULTIPLY_H
+
+/*
+ * The product of a chain of ds::matrix A0 * A1 * ... * An-1 in the order
+ * with the fewest scalar multiplications.
+ *
+ * Matrix multiplication is associative, but the cost is not: with A 10x100,
+ * B 100x5 and C 5x50, (A * B) * C takes 7500 multiplications and
+ * A * (B * C) 75000. matrix_chain_order finds the cheapest parenthesization
+ * of n matrices by dynamic programming in O(n^3) time, from the dimensions
+ * alone.
+ *
+ * The products are not formed with operator*, which would allocate (and
+ * copy the input matrices at the leaves). All intermediate results are
+ * stacked in one scratch buffer sized from the plan, so a left-to-right
+ * chain ping-pongs between two regions; square products use the Winograd
+ * recursion with one workspace for all of them (al/winograd-matrix-multiply.h).
+ * The input matrices are read in place.
+ *
+ * References:
+ * - Cormen, Leiserson, Rivest, Stein: Introduction to Algorithms, 15.2
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "ds/matrix.h"
+#include "al/strassen-matrix-multiply.h"
+#include "al/winograd-matrix-multiply.h"
+#include "al/mm/matrix-view.h"
+
+namespace al {
+
+// The cheapest parenthesization of a chain of matrices, where matrix i is
+// dims[i] x dims[i + 1].
+struct matrix_chain_plan
+{
+  size_t num_matrices;
+  // split[i * num_matrices + j], i < j: the product of matrices i..j is
+  // (i..split) * (split + 1..j)
+  std::vector<size_t> split;
+  // scalar multiplications of the whole chain
+  unsigned long long cost;
+};
+
+inline matrix_chain_plan matrix_chain_order(const std::vector<size_t>& dims)
+{
+  if( dims.size() < 2 )
+    throw std::out_of_range("a matrix chain needs at least one matrix");
+
+  const size_t n = dims.size() - 1;
+  std::vector<unsigned long long> cost(n * n, 0);
+  matrix_chain_plan plan = { n, std::vector<size_t>(n * n, 0), 0 };
+
+  // cost[i * n + j]: the cheapest product of matrices i..j, by length
+  for(size_t length = 2; length <= n; ++length)
+  {
+    for(size_t i = 0; i + length <= n; ++i)
+    {
+      const size_t j = i + length - 1;
+      unsigned long long best = std::numeric_limits<unsigned long long>::max();
+
+      for(size_t k = i; k < j; ++k)
+      {
+        const unsigned long long c = cost[i * n + k] + cost[(k + 1) * n + j] +
+          static_cast<unsigned long long>(dims[i]) * dims[k + 1] * dims[j + 1];
+        if( c < best )
+        {
+          best = c;
+          plan.split[i * n + j] = k;
+        }
+      }
+
+      cost[i * n + j] = best;
+    }
+  }
+
+  plan.cost = cost[n - 1];
+  return plan;
+}
+
+namespace detail {
+
+// Elements of scratch the product of matrices first..last needs besides its
+// own result: the results of both halves (a single matrix is used in
+// place) and, while a half is computed, what that half needs. Raises
+// workspace_size to the Winograd workspace of its square products.
+inline size_t chain_scratch_size(
+  const std::vector<size_t>& dims,
+  const matrix_chain_plan& plan,
+  size_t first,
+  size_t last,
+  size_t crossover_width,
+  size_t& workspace_size
+)
+{
+  if( first == last )
+    return 0;
+
+  const size_t split = plan.split[first * plan.num_matrices + last];
+  const size_t rows = dims[first];
+  const size_t depth = dims[split + 1];
+  const size_t cols = dims[last + 1];
+
+  if( rows == depth && depth == cols )
+  {
+    workspace_size = std::max(
+      workspace_size, mm::winograd_workspace_size(rows, crossover_width)
+    );
+  }
+
+  const size_t left_size = split == first ? 0 : rows * depth;
+  const size_t right_size = split + 1 == last ? 0 : depth * cols;
+
+  const size_t left_scratch = chain_scratch_size(
+    dims, plan, first, split, crossover_width, workspace_size
+  );
+  const size_t right_scratch = chain_scratch_size(
+    dims, plan, split + 1, last, crossover_width, workspace_size
+  );
+
+  return std::max(
+    left_size + left_scratch,
+    left_size + right_size + right_scratch
+  );
+}
+
+// out = left * right, out is tight row-major; square products of row-major
+// operands use the Winograd recursion
+template<typename value_type>
+void chain_multiply_into(
+  ds::matrix_view<const value_type> left,
+  ds::matrix_view<const value_type> right,
+  ds::matrix_view<value_type> out,
+  value_type * workspace,
+  size_t crossover_width
+)
+{
+  typedef mm::matrix_view<const value_type> square_in;
+  typedef mm::matrix_view<value_type> square_out;
+
+  const size_t width = out.get_rows();
+
+  if( left.get_cols() == width && out.get_cols() == width &&
+      left.col_stride() == 1 && right.col_stride() == 1 )
+  {
+    mm::winograd_recurse<value_type>(
+      square_in(left.data(), width, left.row_stride()),
+      square_in(right.data(), width, right.row_stride()),
+      square_out(out.data(), width, out.row_stride()),
+      workspace,
+      crossover_width
+    );
+    return;
+  }
+
+  std::fill(out.data(), out.data() + out.get_rows() * out.get_cols(),
+    value_type());
+  ds::multiply_add<value_type>(left, right, out);
+}
+
+// out = matrices[first] * ... * matrices[last], first < last; the results
+// of the halves are stacked in scratch, single matrices used in place
+template<typename value_type>
+void chain_product(
+  const std::vector<ds::matrix<value_type>>& matrices,
+  const matrix_chain_plan& plan,
+  size_t first,
+  size_t last,
+  ds::matrix_view<value_type> out,
+  value_type * scratch,
+  value_type * workspace,
+  size_t crossover_width
+)
+{
+  typedef ds::matrix_view<const value_type> in_view;
+  typedef ds::matrix_view<value_type> out_view;
+
+  const size_t split = plan.split[first * plan.num_matrices + last];
+  const size_t depth = matrices[split].get_cols();
+
+  in_view left(matrices[first].view());
+  if( split != first )
+  {
+    const out_view product(scratch, out.get_rows(), depth, depth, 1);
+    scratch += out.get_rows() * depth;
+    chain_product(
+      matrices, plan, first, split, product, scratch, workspace,
+      crossover_width
+    );
+    left = product;
+  }
+
+  in_view right(matrices[last].view());
+  if( split + 1 != last )
+  {
+    const out_view product(scratch, depth, out.get_cols(), out.get_cols(), 1);
+    scratch += depth * out.get_cols();
+    chain_product(
+      matrices, plan, split + 1, last, product, scratch, workspace,
+      crossover_width
+    );
+    right = product;
+  }
+
+  chain_multiply_into<value_type>(left, right, out, workspace, crossover_width);
+}
+
+}
+
+// matrices[0] * matrices[1] * ..., multiplied in the order of
+// matrix_chain_order
+template<typename value_type>
+ds::matrix<value_type> matrix_chain_multiply(
+  const std::vector<ds::matrix<value_type>>& matrices,
+  size_t crossover_width = strassen_crossover<value_type>::value
+)
+{
+  if( matrices.empty() )
+    throw std::out_of_range("a matrix chain needs at least one matrix");
+
+  std::vector<size_t> dims(1, matrices[0].get_rows());
+  for(size_t i = 0; i < matrices.size(); ++i)
+  {
+    if( matrices[i].get_rows() != dims.back() )
+      throw std::out_of_range("inner matrix dimensions differ, "
+        "matrix chain multiply impossible");
+
+    dims.push_back(matrices[i].get_cols());
+  }
+
+  if( matrices.size() == 1 )
+    return matrices[0];
+
+  const size_t last = matrices.size() - 1;
+  const matrix_chain_plan plan = matrix_chain_order(dims);
+
+  size_t workspace_size = 0;
+  std::vector<value_type> scratch(detail::chain_scratch_size(
+    dims, plan, 0, last, crossover_width, workspace_size
+  ));
+  std::vector<value_type> workspace(workspace_size);
+
+  ds::matrix<value_type> result(dims.front(), dims.back());
+  detail::chain_product(
+    matrices, plan, 0, last, result.view(),
+    scratch.data(), workspace.data(), crossover_width
+  );
+
+  return result;
+}
+
+}
+
+#endif // AL_MATRIX_CHAIN_MULTIPLY_H
@@ -0,0 +1,136 @@
+#ifndef AL_MATRIX_MULTIPLY_POLICY_H
+#define AL_MATRIX_MULTIPLY_POLICY_H
+
+/*
+ * Matrix multiplication with the algorithm chosen per call, to trade
+ * floating point accuracy for speed:
+ *
+ * - strassen: the fastest for large matrices, but every level of
+ *   recursion adds to the error (the error bound grows with about
+ *   12^levels instead of linearly in the width). max_depth limits the
+ *   levels; every level given up costs up to 8/7 of the time.
+ * - blocked: the classical algorithm, error bound linear in the width.
+ * - kahan: the classical algorithm with compensated sums
+ *   (al/mm/compensated-kernel.h), error bound independent of the width,
+ *   but several times slower than blocked.
+ *
+ * test/benchmark (multiply-accuracy) reports the error and runtime of
+ * each policy.
+ *
+ * References:
+ * - Higham: Accuracy and Stability of Numerical Algorithms, chapter 23
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "al/blocked-matrix-multiply.h"
+#include "al/strassen-matrix-multiply.h"
+#include "al/mm/compensated-kernel.h"
+
+namespace al {
+
+enum class multiply_algorithm
+{
+  strassen,
+  blocked,
+  kahan
+};
+
+struct multiply_policy
+{
+  multiply_algorithm algorithm;
+  // strassen only: the number of recursion levels, the blocked kernel
+  // multiplies the quadrants below
+  size_t max_depth;
+};
+
+inline multiply_policy strassen_policy(
+  size_t max_depth = std::numeric_limits<size_t>::max()
+)
+{
+  multiply_policy policy = { multiply_algorithm::strassen, max_depth };
+  return policy;
+}
+
+inline multiply_policy blocked_policy()
+{
+  multiply_policy policy = { multiply_algorithm::blocked, 0 };
+  return policy;
+}
+
+inline multiply_policy kahan_policy()
+{
+  multiply_policy policy = { multiply_algorithm::kahan, 0 };
+  return policy;
+}
+
+namespace mm {
+
+// The crossover width for strassen_matrix_multiply on width that recurses
+// at most max_depth levels: the width halved (rounding up) max_depth times,
+// but at least crossover_width.
+inline size_t depth_limited_crossover(
+  size_t width,
+  size_t max_depth,
+  size_t crossover_width
+)
+{
+  size_t leaf = width;
+  for(size_t level = 0; level < max_depth && leaf > crossover_width; ++level)
+    leaf = (leaf + 1) / 2;
+
+  return std::max(leaf, crossover_width);
+}
+
+}
+
+template<typename square_matrix>
+square_matrix matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  const multiply_policy& policy
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "matrix multiply impossible");
+  }
+
+  const size_t width = left.get_width();
+
+  if( policy.algorithm == multiply_algorithm::strassen )
+  {
+    return strassen_matrix_multiply(
+      left,
+      right,
+      mm::depth_limited_crossover(
+        width, policy.max_depth, strassen_crossover<value_type>::value
+      )
+    );
+  }
+
+  if( policy.algorithm == multiply_algorithm::blocked )
+    return blocked_matrix_multiply(left, right);
+
+  // kahan
+  square_matrix result(width);
+  mm::compensated_multiply(
+    width, width, width,
+    left.raw_data(), width,
+    right.raw_data(), width,
+    result.raw_data(), width
+  );
+
+  return result;
+}
+
+}
+
+#endif // AL_MATRIX_MULTIPLY_POLICY_H
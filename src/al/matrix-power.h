@@ -0,0 +1,108 @@
+#ifndef AL_MATRIX_POWER_H
+#define AL_MATRIX_POWER_H
+
+/*
+ * base^exponent of a square matrix by repeated squaring: at most
+ * 2 * log2(exponent) products.
+ *
+ * Calling operator* for every product would allocate a result (and the
+ * temporaries of the recursion) each time. Instead, three padded buffers
+ * (the current square, the accumulated product and a target) and one
+ * Winograd workspace (al/winograd-matrix-multiply.h) are allocated up
+ * front, and every product writes into the free buffer, which is then
+ * swapped in. Zero padding is kept by the products, so the operands are
+ * padded once.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "al/strassen-matrix-multiply.h"
+#include "al/winograd-matrix-multiply.h"
+#include "al/mm/matrix-view.h"
+
+namespace al {
+
+template<typename square_matrix>
+square_matrix matrix_power(
+  const square_matrix& base,
+  unsigned long long exponent,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+  typedef mm::matrix_view<value_type> view;
+
+  const size_t width = base.get_width();
+  square_matrix result(width);
+
+  if( exponent == 0 )
+  {
+    for(size_t i = 0; i < width; ++i)
+      result.set(i, i, value_type(1));
+    return result;
+  }
+
+  const size_t padded_width = mm::strassen_padded_width(width, crossover_width);
+  const size_t padded_size = padded_width * padded_width;
+
+  std::vector<value_type> buffers(3 * padded_size, value_type());
+  std::vector<value_type> workspace(
+    mm::winograd_workspace_size(padded_width, crossover_width)
+  );
+
+  value_type * power = buffers.data();
+  value_type * product = buffers.data() + padded_size;
+  value_type * target = buffers.data() + 2 * padded_size;
+
+  mm::copy<value_type>(
+    mm::matrix_view<const value_type>(base.raw_data(), width, width),
+    view(power, width, padded_width)
+  );
+
+  // target = left * right, then target becomes left
+  const auto multiply_into = [&](value_type *& left, value_type * right) {
+    mm::winograd_recurse<value_type>(
+      view(left, padded_width, padded_width),
+      view(right, padded_width, padded_width),
+      view(target, padded_width, padded_width),
+      workspace.data(),
+      crossover_width
+    );
+    std::swap(left, target);
+  };
+
+  bool has_product = false;
+  for(;;)
+  {
+    if( exponent & 1 )
+    {
+      if( has_product )
+        multiply_into(product, power);
+      else
+        std::copy(power, power + padded_size, product);
+      has_product = true;
+    }
+
+    exponent >>= 1;
+    if( !exponent )
+      break;
+
+    multiply_into(power, power);
+  }
+
+  mm::copy<value_type>(
+    mm::matrix_view<const value_type>(product, width, padded_width),
+    view(result.raw_data(), width, width)
+  );
+
+  return result;
+}
+
+}
+
+#endif // AL_MATRIX_POWER_H
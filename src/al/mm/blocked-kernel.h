@@ -0,0 +1,291 @@
+#ifndef AL_MM_BLOCKED_KERNEL_H
+#define AL_MM_BLOCKED_KERNEL_H
+
+/*
+ * A cache blocked, register tiled classical matrix multiply (C += A * B).
+ *
+ * Every matrix is addressed by a row stride and a column stride, element
+ * (r, c) is at r * row_stride + c * col_stride. This covers row-major
+ * (row_stride is the leading dimension, col_stride 1) and column-major
+ * (row_stride 1, col_stride is the leading dimension) matrices as well as
+ * windows into larger matrices.
+ *
+ * The loop structure follows GotoBLAS:
+ * - B is packed in panels of depth_block x col_block (fits in L3)
+ * - A is packed in blocks of row_block x depth_block (fits in L2)
+ * - a micro kernel multiplies a tile_rows x depth_block sliver of A with a
+ *   depth_block x tile_cols sliver of B into a tile_rows x tile_cols tile
+ *   of accumulators, which the compiler keeps in (vector) registers
+ *
+ * Packing copies each sliver into contiguous memory, in exactly the order
+ * the micro kernel reads it, whatever the layout of A and B. Slivers at the
+ * edges are padded with zeroes, so the micro kernel never branches on the
+ * matrix size.
+ *
+ * References:
+ * - Goto, van de Geijn: Anatomy of High-Performance Matrix Multiplication
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace al {
+namespace mm {
+
+template<typename value_type>
+struct block_sizes
+{
+  static const size_t tile_rows = 4;
+  static const size_t tile_cols = 8;
+  // multiples of tile_rows and tile_cols
+  static const size_t row_block = 64;
+  static const size_t depth_block = 256;
+  static const size_t col_block = 1024;
+};
+
+template<typename value_type>
+const size_t block_sizes<value_type>::tile_rows;
+template<typename value_type>
+const size_t block_sizes<value_type>::tile_cols;
+template<typename value_type>
+const size_t block_sizes<value_type>::row_block;
+template<typename value_type>
+const size_t block_sizes<value_type>::depth_block;
+template<typename value_type>
+const size_t block_sizes<value_type>::col_block;
+
+namespace detail {
+
+template<typename value_type>
+void pack_a(
+  size_t rows,
+  size_t depth,
+  const value_type * a,
+  size_t a_row_stride,
+  size_t a_col_stride,
+  value_type * packed
+)
+{
+  const size_t tile_rows = block_sizes<value_type>::tile_rows;
+
+  for(size_t i = 0; i < rows; i += tile_rows)
+  {
+    const size_t sliver_rows = std::min(tile_rows, rows - i);
+    for(size_t p = 0; p < depth; ++p)
+    {
+      const value_type * col = a + i * a_row_stride + p * a_col_stride;
+      size_t r = 0;
+      for(; r < sliver_rows; ++r)
+        *packed++ = col[r * a_row_stride];
+      for(; r < tile_rows; ++r)
+        *packed++ = value_type();
+    }
+  }
+}
+
+template<typename value_type>
+void pack_b(
+  size_t depth,
+  size_t cols,
+  const value_type * b,
+  size_t b_row_stride,
+  size_t b_col_stride,
+  value_type * packed
+)
+{
+  const size_t tile_cols = block_sizes<value_type>::tile_cols;
+
+  for(size_t j = 0; j < cols; j += tile_cols)
+  {
+    const size_t sliver_cols = std::min(tile_cols, cols - j);
+    for(size_t p = 0; p < depth; ++p)
+    {
+      const value_type * row = b + p * b_row_stride + j * b_col_stride;
+      size_t c = 0;
+      if( b_col_stride == 1 )
+      {
+        for(; c < sliver_cols; ++c)
+          *packed++ = row[c];
+      }
+      else
+      {
+        for(; c < sliver_cols; ++c)
+          *packed++ = row[c * b_col_stride];
+      }
+      for(; c < tile_cols; ++c)
+        *packed++ = value_type();
+    }
+  }
+}
+
+// multiply a packed sliver of A with a packed sliver of B, add the
+// top left rows x cols of the resulting tile to C
+template<typename value_type>
+void micro_kernel(
+  size_t depth,
+  const value_type * a,
+  const value_type * b,
+  value_type * c,
+  size_t c_row_stride,
+  size_t c_col_stride,
+  size_t rows,
+  size_t cols
+)
+{
+  const size_t tile_rows = block_sizes<value_type>::tile_rows;
+  const size_t tile_cols = block_sizes<value_type>::tile_cols;
+
+  value_type acc[tile_rows][tile_cols] = {};
+
+  for(size_t p = 0; p < depth; ++p)
+  {
+    for(size_t i = 0; i < tile_rows; ++i)
+    {
+      const value_type a_val = a[i];
+      for(size_t j = 0; j < tile_cols; ++j)
+        acc[i][j] += a_val * b[j];
+    }
+
+    a += tile_rows;
+    b += tile_cols;
+  }
+
+  if( rows == tile_rows && cols == tile_cols && c_col_stride == 1 )
+  {
+    for(size_t i = 0; i < tile_rows; ++i)
+      for(size_t j = 0; j < tile_cols; ++j)
+        c[i * c_row_stride + j] += acc[i][j];
+  }
+  else
+  {
+    for(size_t i = 0; i < rows; ++i)
+      for(size_t j = 0; j < cols; ++j)
+        c[i * c_row_stride + j * c_col_stride] += acc[i][j];
+  }
+}
+
+inline size_t round_up(size_t value, size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace detail
+
+// C (rows x cols) += A (rows x depth) * B (depth x cols)
+template<typename value_type>
+void blocked_multiply_add(
+  size_t rows,
+  size_t cols,
+  size_t depth,
+  const value_type * a,
+  size_t a_row_stride,
+  size_t a_col_stride,
+  const value_type * b,
+  size_t b_row_stride,
+  size_t b_col_stride,
+  value_type * c,
+  size_t c_row_stride,
+  size_t c_col_stride
+)
+{
+  typedef block_sizes<value_type> bs;
+
+  // performance assumption: the packing buffers are reused by all calls
+  // on this thread, e.g. by every leaf of a strassen recursion
+  thread_local std::vector<value_type> packed_a;
+  thread_local std::vector<value_type> packed_b;
+
+  const size_t max_rows = std::min(bs::row_block, rows);
+  const size_t max_cols = std::min(bs::col_block, cols);
+  const size_t max_depth = std::min(bs::depth_block, depth);
+
+  const size_t a_size = detail::round_up(max_rows, bs::tile_rows) * max_depth;
+  const size_t b_size = detail::round_up(max_cols, bs::tile_cols) * max_depth;
+  if( packed_a.size() < a_size )
+    packed_a.resize(a_size);
+  if( packed_b.size() < b_size )
+    packed_b.resize(b_size);
+
+  for(size_t jc = 0; jc < cols; jc += bs::col_block)
+  {
+    const size_t block_cols = std::min(bs::col_block, cols - jc);
+
+    for(size_t pc = 0; pc < depth; pc += bs::depth_block)
+    {
+      const size_t block_depth = std::min(bs::depth_block, depth - pc);
+
+      detail::pack_b(
+        block_depth,
+        block_cols,
+        b + pc * b_row_stride + jc * b_col_stride,
+        b_row_stride,
+        b_col_stride,
+        packed_b.data()
+      );
+
+      for(size_t ic = 0; ic < rows; ic += bs::row_block)
+      {
+        const size_t block_rows = std::min(bs::row_block, rows - ic);
+
+        detail::pack_a(
+          block_rows,
+          block_depth,
+          a + ic * a_row_stride + pc * a_col_stride,
+          a_row_stride,
+          a_col_stride,
+          packed_a.data()
+        );
+
+        for(size_t jr = 0; jr < block_cols; jr += bs::tile_cols)
+        {
+          const value_type * b_sliver = packed_b.data() + jr * block_depth;
+          const size_t tile_cols = std::min(bs::tile_cols, block_cols - jr);
+
+          for(size_t ir = 0; ir < block_rows; ir += bs::tile_rows)
+          {
+            detail::micro_kernel(
+              block_depth,
+              packed_a.data() + ir * block_depth,
+              b_sliver,
+              c + (ic + ir) * c_row_stride + (jc + jr) * c_col_stride,
+              c_row_stride,
+              c_col_stride,
+              std::min(bs::tile_rows, block_rows - ir),
+              tile_cols
+            );
+          }
+        }
+      }
+    }
+  }
+}
+
+// C (rows x cols) += A (rows x depth) * B (depth x cols),
+// all row-major with leading dimensions lda, ldb and ldc
+template<typename value_type>
+void blocked_multiply_add(
+  size_t rows,
+  size_t cols,
+  size_t depth,
+  const value_type * a,
+  size_t lda,
+  const value_type * b,
+  size_t ldb,
+  value_type * c,
+  size_t ldc
+)
+{
+  blocked_multiply_add(
+    rows, cols, depth,
+    a, lda, static_cast<size_t>(1),
+    b, ldb, static_cast<size_t>(1),
+    c, ldc, static_cast<size_t>(1)
+  );
+}
+
+}
+}
+
+#endif // AL_MM_BLOCKED_KERNEL_H
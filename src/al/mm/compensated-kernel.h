@@ -0,0 +1,74 @@
+#ifndef AL_MM_COMPENSATED_KERNEL_H
+#define AL_MM_COMPENSATED_KERNEL_H
+
+/*
+ * Classical matrix multiply (C = A * B, row-major) with Kahan compensated
+ * summation: every element of C carries a compensation term with the
+ * rounding error of its running sum, so the accumulated error doesn't grow
+ * with the width (only the rounding of the single products remains).
+ *
+ * The loop order i-k-j keeps the sums and compensations of one row of C in
+ * two arrays, and the innermost loop runs over them and a row of B, so it
+ * vectorizes without changing the order of any floating point operation.
+ * Still several times slower than the blocked kernel.
+ *
+ * The compiler must not reassociate floating point operations
+ * (-ffast-math), which would optimize the compensation away.
+ *
+ * References:
+ * - Kahan: Further remarks on reducing truncation errors
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace al {
+namespace mm {
+
+template<typename value_type>
+void compensated_multiply(
+  size_t rows,
+  size_t cols,
+  size_t depth,
+  const value_type * a,
+  size_t lda,
+  const value_type * b,
+  size_t ldb,
+  value_type * c,
+  size_t ldc
+)
+{
+  std::vector<value_type> sum(cols), compensation(cols);
+
+  for(size_t i = 0; i < rows; ++i)
+  {
+    std::fill(sum.begin(), sum.end(), value_type());
+    std::fill(compensation.begin(), compensation.end(), value_type());
+
+    value_type * s = sum.data();
+    value_type * comp = compensation.data();
+
+    for(size_t k = 0; k < depth; ++k)
+    {
+      const value_type factor = a[i * lda + k];
+      const value_type * b_row = b + k * ldb;
+
+      for(size_t j = 0; j < cols; ++j)
+      {
+        const value_type y = factor * b_row[j] - comp[j];
+        const value_type t = s[j] + y;
+        comp[j] = (t - s[j]) - y;
+        s[j] = t;
+      }
+    }
+
+    std::copy(sum.begin(), sum.end(), c + i * ldc);
+  }
+}
+
+}
+}
+
+#endif // AL_MM_COMPENSATED_KERNEL_H
@@ -0,0 +1,343 @@
+#ifndef AL_MM_ELEMENTWISE_H
+#define AL_MM_ELEMENTWISE_H
+
+/*
+ * Explicitly vectorized element wise kernels on contiguous arrays:
+ *   add:      out[i] = left[i] + right[i]
+ *   subtract: out[i] = left[i] - right[i]
+ *   scale:    out[i] = in[i] * factor
+ *   copy:     out[i] = in[i]
+ * out may alias the operands exactly (but not partially).
+ *
+ * With gcc and clang the kernels are written with vector extensions
+ * (32 byte vectors of any arithmetic type) and instantiated twice: once for
+ * the baseline instruction set (SSE2 on x86_64, NEON on arm64, ...) and once
+ * with __attribute__((target("avx2"))). On x86 the AVX2 version is chosen at
+ * runtime if the cpu supports it, so the binary doesn't require AVX2.
+ * Other compilers and non-arithmetic types get plain loops.
+ *
+ * copy uses std::copy, which ends up in memmove for arithmetic types;
+ * libc already dispatches that to the widest vector instructions.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "util/cpu-features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define AL_MM_ELEMENTWISE_X86_DISPATCH 1
+#else
+  #define AL_MM_ELEMENTWISE_X86_DISPATCH 0
+#endif
+
+namespace al {
+namespace mm {
+namespace elementwise {
+
+namespace detail {
+
+struct op_add
+{
+  // by reference: passing vectors by value changes the ABI depending on
+  // the instruction set
+  template<typename value_type>
+  static void apply(
+    const value_type& left,
+    const value_type& right,
+    value_type& out
+  )
+  {
+    out = left + right;
+  }
+};
+
+struct op_subtract
+{
+  template<typename value_type>
+  static void apply(
+    const value_type& left,
+    const value_type& right,
+    value_type& out
+  )
+  {
+    out = left - right;
+  }
+};
+
+struct op_multiply
+{
+  template<typename value_type>
+  static void apply(
+    const value_type& left,
+    const value_type& right,
+    value_type& out
+  )
+  {
+    out = left * right;
+  }
+};
+
+template<typename operation, typename value_type>
+void scalar_loop(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  for(size_t i = 0; i < num; ++i)
+    operation::apply(left[i], right[i], out[i]);
+}
+
+template<typename operation, typename value_type>
+void scalar_broadcast_loop(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+  for(size_t i = 0; i < num; ++i)
+    operation::apply(left[i], right, out[i]);
+}
+
+#if defined(__GNUC__)
+
+template<typename value_type>
+struct vector_of
+{
+  typedef value_type type __attribute__((vector_size(32)));
+  static const size_t lanes = 32 / sizeof(value_type);
+};
+
+// always inlined into the instruction set specific entry points below,
+// which decide the instructions the vector operations compile to
+template<typename operation, typename value_type>
+inline __attribute__((always_inline)) void vector_loop(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  typedef typename vector_of<value_type>::type vector;
+  const size_t lanes = vector_of<value_type>::lanes;
+
+  size_t i = 0;
+  for(; i + lanes <= num; i += lanes)
+  {
+    // memcpy compiles to unaligned vector loads and stores
+    vector l, r, o;
+    std::memcpy(&l, left + i, sizeof(vector));
+    std::memcpy(&r, right + i, sizeof(vector));
+    operation::apply(l, r, o);
+    std::memcpy(out + i, &o, sizeof(vector));
+  }
+
+  scalar_loop<operation>(left + i, right + i, out + i, num - i);
+}
+
+template<typename operation, typename value_type>
+inline __attribute__((always_inline)) void vector_broadcast_loop(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+  typedef typename vector_of<value_type>::type vector;
+  const size_t lanes = vector_of<value_type>::lanes;
+
+  vector r;
+  for(size_t lane = 0; lane < lanes; ++lane)
+    r[lane] = right;
+
+  size_t i = 0;
+  for(; i + lanes <= num; i += lanes)
+  {
+    vector l, o;
+    std::memcpy(&l, left + i, sizeof(vector));
+    operation::apply(l, r, o);
+    std::memcpy(out + i, &o, sizeof(vector));
+  }
+
+  scalar_broadcast_loop<operation>(left + i, right, out + i, num - i);
+}
+
+template<typename operation, typename value_type>
+void baseline_kernel(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  vector_loop<operation>(left, right, out, num);
+}
+
+template<typename operation, typename value_type>
+void baseline_broadcast_kernel(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+  vector_broadcast_loop<operation>(left, right, out, num);
+}
+
+#endif
+
+#if AL_MM_ELEMENTWISE_X86_DISPATCH
+
+template<typename operation, typename value_type>
+__attribute__((target("avx2"))) void avx2_kernel(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  vector_loop<operation>(left, right, out, num);
+}
+
+template<typename operation, typename value_type>
+__attribute__((target("avx2"))) void avx2_broadcast_kernel(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+  vector_broadcast_loop<operation>(left, right, out, num);
+}
+
+#endif
+
+template<typename value_type>
+struct is_vectorizable
+: std::integral_constant<
+    bool,
+    std::is_arithmetic<value_type>::value &&
+    !std::is_same<value_type, bool>::value &&
+    !std::is_same<value_type, long double>::value
+  >
+{};
+
+template<typename operation, typename value_type>
+typename std::enable_if<is_vectorizable<value_type>::value>::type
+dispatch(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+#if AL_MM_ELEMENTWISE_X86_DISPATCH
+  if( util::cpu_has_avx2() )
+    avx2_kernel<operation>(left, right, out, num);
+  else
+    baseline_kernel<operation>(left, right, out, num);
+#elif defined(__GNUC__)
+  baseline_kernel<operation>(left, right, out, num);
+#else
+  scalar_loop<operation>(left, right, out, num);
+#endif
+}
+
+template<typename operation, typename value_type>
+typename std::enable_if<!is_vectorizable<value_type>::value>::type
+dispatch(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  scalar_loop<operation>(left, right, out, num);
+}
+
+template<typename operation, typename value_type>
+typename std::enable_if<is_vectorizable<value_type>::value>::type
+dispatch_broadcast(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+#if AL_MM_ELEMENTWISE_X86_DISPATCH
+  if( util::cpu_has_avx2() )
+    avx2_broadcast_kernel<operation>(left, right, out, num);
+  else
+    baseline_broadcast_kernel<operation>(left, right, out, num);
+#elif defined(__GNUC__)
+  baseline_broadcast_kernel<operation>(left, right, out, num);
+#else
+  scalar_broadcast_loop<operation>(left, right, out, num);
+#endif
+}
+
+template<typename operation, typename value_type>
+typename std::enable_if<!is_vectorizable<value_type>::value>::type
+dispatch_broadcast(
+  const value_type * left,
+  value_type right,
+  value_type * out,
+  size_t num
+)
+{
+  scalar_broadcast_loop<operation>(left, right, out, num);
+}
+
+} // namespace detail
+
+template<typename value_type>
+void add(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  detail::dispatch<detail::op_add>(left, right, out, num);
+}
+
+template<typename value_type>
+void subtract(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t num
+)
+{
+  detail::dispatch<detail::op_subtract>(left, right, out, num);
+}
+
+template<typename value_type>
+void scale(
+  const value_type * in,
+  value_type factor,
+  value_type * out,
+  size_t num
+)
+{
+  detail::dispatch_broadcast<detail::op_multiply>(in, factor, out, num);
+}
+
+template<typename value_type>
+void copy(const value_type * in, value_type * out, size_t num)
+{
+  if( in != out )
+    std::copy(in, in + num, out);
+}
+
+}
+}
+}
+
+#endif // AL_MM_ELEMENTWISE_H
@@ -0,0 +1,136 @@
+#ifndef AL_MM_GEMV_KERNEL_H
+#define AL_MM_GEMV_KERNEL_H
+
+/*
+ * Matrix-vector multiply (y += A * x) on a strided matrix, see
+ * al/mm/blocked-kernel.h for the addressing.
+ *
+ * Every element of A is used exactly once, so the product is bound by
+ * memory bandwidth; the kernels just make sure A is read in storage order:
+ * - row-major A: dot products of four rows at a time with x
+ * - column-major A: y += x[c] * column c, for four columns at a time;
+ *   vectorized across rows, the four products of a row are summed before
+ *   they are added to y, so float results may differ from adding one
+ *   column at a time
+ *
+ */
+
+#include <cstddef>
+
+namespace al {
+namespace mm {
+
+namespace detail {
+
+template<typename value_type>
+void gemv_rows(
+  size_t rows,
+  size_t cols,
+  const value_type * a,
+  size_t a_rs,
+  const value_type * x,
+  value_type * y
+)
+{
+  size_t r = 0;
+  for(; r + 4 <= rows; r += 4)
+  {
+    const value_type * a0 = a + r * a_rs;
+    const value_type * a1 = a0 + a_rs;
+    const value_type * a2 = a1 + a_rs;
+    const value_type * a3 = a2 + a_rs;
+
+    value_type s0 = value_type(), s1 = value_type();
+    value_type s2 = value_type(), s3 = value_type();
+    for(size_t c = 0; c < cols; ++c)
+    {
+      const value_type xc = x[c];
+      s0 += a0[c] * xc;
+      s1 += a1[c] * xc;
+      s2 += a2[c] * xc;
+      s3 += a3[c] * xc;
+    }
+
+    y[r] += s0;
+    y[r + 1] += s1;
+    y[r + 2] += s2;
+    y[r + 3] += s3;
+  }
+
+  for(; r < rows; ++r)
+  {
+    const value_type * row = a + r * a_rs;
+    value_type sum = value_type();
+    for(size_t c = 0; c < cols; ++c)
+      sum += row[c] * x[c];
+
+    y[r] += sum;
+  }
+}
+
+template<typename value_type>
+void gemv_cols(
+  size_t rows,
+  size_t cols,
+  const value_type * a,
+  size_t a_cs,
+  const value_type * x,
+  value_type * y
+)
+{
+  size_t c = 0;
+  for(; c + 4 <= cols; c += 4)
+  {
+    const value_type * a0 = a + c * a_cs;
+    const value_type * a1 = a0 + a_cs;
+    const value_type * a2 = a1 + a_cs;
+    const value_type * a3 = a2 + a_cs;
+
+    const value_type x0 = x[c], x1 = x[c + 1], x2 = x[c + 2], x3 = x[c + 3];
+    for(size_t r = 0; r < rows; ++r)
+      y[r] += a0[r] * x0 + a1[r] * x1 + a2[r] * x2 + a3[r] * x3;
+  }
+
+  for(; c < cols; ++c)
+  {
+    const value_type * col = a + c * a_cs;
+    const value_type xc = x[c];
+    for(size_t r = 0; r < rows; ++r)
+      y[r] += col[r] * xc;
+  }
+}
+
+}
+
+// y += A * x, with A rows x cols, x of cols and y of rows elements
+template<typename value_type>
+void gemv_multiply_add(
+  size_t rows,
+  size_t cols,
+  const value_type * a,
+  size_t a_rs,
+  size_t a_cs,
+  const value_type * x,
+  value_type * y
+)
+{
+  if( a_cs == 1 )
+  {
+    detail::gemv_rows(rows, cols, a, a_rs, x, y);
+  }
+  else if( a_rs == 1 )
+  {
+    detail::gemv_cols(rows, cols, a, a_cs, x, y);
+  }
+  else
+  {
+    for(size_t r = 0; r < rows; ++r)
+      for(size_t c = 0; c < cols; ++c)
+        y[r] += a[r * a_rs + c * a_cs] * x[c];
+  }
+}
+
+}
+}
+
+#endif // AL_MM_GEMV_KERNEL_H
@@ -0,0 +1,142 @@
+#ifndef AL_MM_MATRIX_VIEW_H
+#define AL_MM_MATRIX_VIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "al/mm/elementwise.h"
+
+namespace al {
+namespace mm {
+
+// A non-owning square window into a row-major buffer.
+// Rows are stride elements apart, which allows views into quadrants of
+// larger matrices without copying them.
+template<typename value_type>
+class matrix_view
+{
+  public:
+    matrix_view(value_type * data, size_t view_width, size_t row_stride)
+    : begin(data),
+      width(view_width),
+      stride(row_stride)
+    {
+    }
+
+    // implicit conversion from a mutable to a const view
+    template<
+      typename other_type,
+      typename = typename std::enable_if<
+        std::is_convertible<other_type *, value_type *>::value
+      >::type
+    >
+    matrix_view(const matrix_view<other_type>& other)
+    : begin(other.data()),
+      width(other.get_width()),
+      stride(other.get_stride())
+    {
+    }
+
+    value_type * data() const
+    {
+      return this->begin;
+    }
+
+    value_type * row(size_t index) const
+    {
+      return this->begin + index * this->stride;
+    }
+
+    size_t get_width() const
+    {
+      return this->width;
+    }
+
+    size_t get_stride() const
+    {
+      return this->stride;
+    }
+
+    // 0: top left, 1: top right, 2: bottom left, 3: bottom right
+    // (same order as square_matrix::square_split())
+    matrix_view quadrant(size_t index) const
+    {
+      const size_t half = this->width / 2;
+      const size_t row_offset = (index >> 1) * half;
+      const size_t col_offset = (index & 1) * half;
+
+      return matrix_view(
+        this->begin + row_offset * this->stride + col_offset,
+        half,
+        this->stride
+      );
+    }
+
+  private:
+    value_type * begin;
+    size_t width;
+    size_t stride;
+};
+
+// element wise helpers for views of equal width; out may alias an operand
+
+template<typename value_type>
+void fill(matrix_view<value_type> out, value_type val)
+{
+  for(size_t r = 0; r < out.get_width(); ++r)
+    std::fill(out.row(r), out.row(r) + out.get_width(), val);
+}
+
+template<typename value_type>
+void copy(matrix_view<const value_type> in, matrix_view<value_type> out)
+{
+  for(size_t r = 0; r < out.get_width(); ++r)
+    elementwise::copy(in.row(r), out.row(r), out.get_width());
+}
+
+template<typename value_type>
+void add(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out
+)
+{
+  for(size_t r = 0; r < out.get_width(); ++r)
+    elementwise::add(left.row(r), right.row(r), out.row(r), out.get_width());
+}
+
+template<typename value_type>
+void subtract(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out
+)
+{
+  for(size_t r = 0; r < out.get_width(); ++r)
+  {
+    elementwise::subtract(
+      left.row(r), right.row(r), out.row(r), out.get_width()
+    );
+  }
+}
+
+template<typename value_type>
+void add_to(matrix_view<const value_type> in, matrix_view<value_type> out)
+{
+  add<value_type>(out, in, out);
+}
+
+template<typename value_type>
+void subtract_from(
+  matrix_view<const value_type> in,
+  matrix_view<value_type> out
+)
+{
+  subtract<value_type>(out, in, out);
+}
+
+}
+}
+
+#endif // AL_MM_MATRIX_VIEW_H
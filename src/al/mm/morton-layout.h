@@ -0,0 +1,156 @@
+#ifndef AL_MM_MORTON_LAYOUT_H
+#define AL_MM_MORTON_LAYOUT_H
+
+/*
+ * The Morton (Z-order) tiled layout of a square matrix.
+ *
+ * A padded_width x padded_width matrix (padded_width = leaf_width << levels)
+ * is cut into leaf_width x leaf_width tiles, each stored row-major and
+ * contiguous. The tiles are ordered along the Z curve: the four quadrants
+ * of the matrix follow each other (top left, top right, bottom left,
+ * bottom right), and so do the four quadrants of every quadrant, down to
+ * the single tiles:
+ *
+ *    0  1 |  4  5
+ *    2  3 |  6  7
+ *   ------+------
+ *    8  9 | 12 13
+ *   10 11 | 14 15
+ *
+ * At every recursion level of a divide and conquer algorithm like Strassen's
+ * a quadrant is therefore one contiguous block of half * half elements at
+ * offset quadrant * half * half.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+
+#include "al/mm/elementwise.h"
+#include "al/mm/matrix-view.h"
+
+namespace al {
+namespace mm {
+
+namespace detail {
+
+// every other bit of index, e.g. 0b101101 -> 0b111
+inline size_t morton_compact(size_t index)
+{
+  size_t result = 0;
+  for(size_t bit = 0; (index >> (2 * bit)) != 0; ++bit)
+    result |= ((index >> (2 * bit)) & 1) << bit;
+
+  return result;
+}
+
+// calls func(tile_row, tile_col, tile_offset) for every tile, in Z-order
+template<typename function>
+void for_each_morton_tile(
+  size_t padded_width,
+  size_t leaf_width,
+  function func
+)
+{
+  const size_t tiles_per_row = padded_width / leaf_width;
+  const size_t num_tiles = tiles_per_row * tiles_per_row;
+  const size_t tile_size = leaf_width * leaf_width;
+
+  for(size_t tile = 0; tile < num_tiles; ++tile)
+  {
+    func(
+      detail::morton_compact(tile >> 1) * leaf_width,
+      detail::morton_compact(tile) * leaf_width,
+      tile * tile_size
+    );
+  }
+}
+
+}
+
+// The width of the leaves of the strassen recursion on padded_width, and
+// so the tile width of its Morton layout: padded_width halved until it is
+// at most crossover_width or odd.
+inline size_t morton_leaf_width(size_t padded_width, size_t crossover_width)
+{
+  size_t leaf = padded_width;
+  while( leaf > std::max<size_t>(crossover_width, 1) && !(leaf & 1) )
+    leaf /= 2;
+
+  return leaf;
+}
+
+// Writes the row-major in to out in Morton layout, zero padded to
+// padded_width. out must hold padded_width * padded_width elements.
+template<typename value_type>
+void to_morton(
+  matrix_view<const value_type> in,
+  value_type * out,
+  size_t padded_width,
+  size_t leaf_width
+)
+{
+  const size_t width = in.get_width();
+
+  detail::for_each_morton_tile(padded_width, leaf_width,
+    [&](size_t tile_row, size_t tile_col, size_t offset) {
+      value_type * tile = out + offset;
+
+      // the part of the tile inside of in, the rest is padding
+      const size_t rows = tile_row < width
+        ? std::min(leaf_width, width - tile_row) : 0;
+      const size_t cols = tile_col < width
+        ? std::min(leaf_width, width - tile_col) : 0;
+
+      for(size_t r = 0; r < rows; ++r)
+      {
+        elementwise::copy(
+          in.row(tile_row + r) + tile_col, tile + r * leaf_width, cols
+        );
+        std::fill(
+          tile + r * leaf_width + cols, tile + (r + 1) * leaf_width,
+          value_type()
+        );
+      }
+
+      std::fill(
+        tile + rows * leaf_width, tile + leaf_width * leaf_width, value_type()
+      );
+    }
+  );
+}
+
+// Writes the top left out.get_width() square of the Morton layout matrix in
+// to the row-major out.
+template<typename value_type>
+void from_morton(
+  const value_type * in,
+  matrix_view<value_type> out,
+  size_t padded_width,
+  size_t leaf_width
+)
+{
+  const size_t width = out.get_width();
+
+  detail::for_each_morton_tile(padded_width, leaf_width,
+    [&](size_t tile_row, size_t tile_col, size_t offset) {
+      if( tile_row >= width || tile_col >= width )
+        return;
+
+      const size_t rows = std::min(leaf_width, width - tile_row);
+      const size_t cols = std::min(leaf_width, width - tile_col);
+
+      for(size_t r = 0; r < rows; ++r)
+      {
+        elementwise::copy(
+          in + offset + r * leaf_width, out.row(tile_row + r) + tile_col, cols
+        );
+      }
+    }
+  );
+}
+
+}
+}
+
+#endif // AL_MM_MORTON_LAYOUT_H
@@ -0,0 +1,167 @@
+#ifndef AL_MODULAR_MATRIX_MULTIPLY_H
+#define AL_MODULAR_MATRIX_MULTIPLY_H
+
+/*
+ * Matrix multiplication over the integers modulo p, p < 2^32, with delayed
+ * reduction.
+ *
+ * Reducing every product modulo p costs a division per multiply-add. With
+ * the operands reduced to [0, p), a product is at most (p - 1)^2, so a
+ * 64 bit accumulator holding a value below p takes
+ * (2^64 - 1 - (p - 1)) / (p - 1)^2 more products before it can overflow;
+ * only then is it reduced. For p below 2^16 this is more than 2^32
+ * products, so every element is reduced just once, at the end; for a p
+ * near 2^32 it is every product again.
+ *
+ * The classical i-k-j loop accumulates a row of the result in 64 bit
+ * accumulators, over panels of the columns of the right operand so that the
+ * panel stays in cache.
+ *
+ * References:
+ * - Dumas, Giorgi, Pernet: Dense Linear Algebra over Word-Size Prime Fields:
+ *   the FFLAS and FFPACK Packages
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace al {
+
+namespace mm {
+
+// the number of products of two values below modulus which can be added to
+// a 64 bit value below modulus without overflow
+inline uint64_t modular_delay(uint64_t modulus)
+{
+  const uint64_t max_factor = modulus - 1;
+  if( max_factor == 0 )
+    return std::numeric_limits<uint64_t>::max();
+
+  return (std::numeric_limits<uint64_t>::max() - max_factor) /
+    (max_factor * max_factor);
+}
+
+// value mod modulus in [0, modulus), also for negative values
+template<typename value_type>
+uint32_t modular_reduce(value_type value, uint32_t modulus)
+{
+  if( std::is_signed<value_type>::value && value < value_type() )
+  {
+    const long long remainder = static_cast<long long>(value) % modulus;
+    return static_cast<uint32_t>(remainder == 0 ? 0 : remainder + modulus);
+  }
+
+  return static_cast<uint32_t>(
+    static_cast<unsigned long long>(value) % modulus
+  );
+}
+
+// out = left * right mod modulus, row-major width x width, all values of
+// left and right in [0, modulus)
+inline void modular_multiply(
+  size_t width,
+  const uint32_t * left,
+  const uint32_t * right,
+  uint32_t * out,
+  uint32_t modulus
+)
+{
+  const size_t panel_width = 512;
+  const uint64_t delay = modular_delay(modulus);
+
+  std::vector<uint64_t> acc(std::min(panel_width, width));
+
+  for(size_t panel = 0; panel < width; panel += panel_width)
+  {
+    const size_t cols = std::min(panel_width, width - panel);
+
+    for(size_t i = 0; i < width; ++i)
+    {
+      std::fill(acc.begin(), acc.begin() + cols, 0);
+      uint64_t pending = 0;
+
+      for(size_t k = 0; k < width; ++k)
+      {
+        if( pending == delay )
+        {
+          for(size_t j = 0; j < cols; ++j)
+            acc[j] %= modulus;
+          pending = 0;
+        }
+
+        const uint64_t factor = left[i * width + k];
+        const uint32_t * b_row = right + k * width + panel;
+        uint64_t * a = acc.data();
+        for(size_t j = 0; j < cols; ++j)
+          a[j] += factor * b_row[j];
+        ++pending;
+      }
+
+      for(size_t j = 0; j < cols; ++j)
+        out[i * width + panel + j] = static_cast<uint32_t>(acc[j] % modulus);
+    }
+  }
+}
+
+}
+
+// left * right with all arithmetic modulo modulus; elements of the result
+// are in [0, modulus), negative elements of the operands are taken as their
+// residue. modulus - 1 must fit in the element type, so the result does.
+template<typename square_matrix>
+square_matrix modular_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  uint32_t modulus
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+  static_assert(std::is_integral<value_type>::value,
+    "modular matrix multiply needs integral values");
+
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "modular matrix multiply impossible");
+  }
+
+  if( modulus == 0 )
+    throw std::out_of_range("modulus must be at least 1");
+
+  if( uint64_t(modulus - 1) >
+      uint64_t(std::numeric_limits<value_type>::max()) )
+  {
+    throw std::out_of_range("modulus exceeds the element type, "
+      "modular matrix multiply impossible");
+  }
+
+  const size_t width = left.get_width();
+  const size_t size = width * width;
+
+  std::vector<uint32_t> l(size);
+  std::vector<uint32_t> r(size);
+  std::vector<uint32_t> out(size);
+  for(size_t i = 0; i < size; ++i)
+  {
+    l[i] = mm::modular_reduce(left.raw_data()[i], modulus);
+    r[i] = mm::modular_reduce(right.raw_data()[i], modulus);
+  }
+
+  mm::modular_multiply(width, l.data(), r.data(), out.data(), modulus);
+
+  square_matrix result(width);
+  for(size_t i = 0; i < size; ++i)
+    result.raw_data()[i] = static_cast<value_type>(out[i]);
+
+  return result;
+}
+
+}
+
+#endif // AL_MODULAR_MATRIX_MULTIPLY_H
@@ -0,0 +1,98 @@
+#ifndef AL_PARALLEL_GREP_H
+#define AL_PARALLEL_GREP_H
+
+/*
+ * Finds all occurrences of a pattern in a large buffer or file, with the
+ * search split into tasks on a util::thread_pool.
+ *
+ * The text is split into chunks of chunk_size characters. A task searches
+ * its chunk plus the first pattern length - 1 characters of the next one,
+ * and keeps the occurrences starting in its own chunk, so occurrences
+ * straddling two chunks are found exactly once. Since the chunks are in
+ * order, concatenating the offsets of the tasks sorts them.
+ *
+ * Files are mapped into memory with util::mapped_file; the tasks read
+ * their chunks straight from the page cache.
+ *
+ * searcher_type is e.g. al::boyer_moore_substring<const char *>, anything
+ * with get_pattern_length() and find_all(begin, end, func) on pointers;
+ * it is shared by all tasks, so find_all must be const.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "util/mapped-file.h"
+#include "util/thread-pool.h"
+
+namespace al {
+
+// offsets of all occurrences in [data, data + size), ascending
+template<typename searcher_type>
+std::vector<uint64_t> parallel_find_all(
+  const searcher_type& searcher,
+  const char * data,
+  size_t size,
+  util::thread_pool& pool,
+  size_t chunk_size = 4 << 20
+)
+{
+  std::vector<uint64_t> offsets;
+  if( searcher.get_pattern_length() < 1 )
+    return offsets;
+
+  const size_t overlap = static_cast<size_t>(searcher.get_pattern_length()) - 1;
+  chunk_size = std::max<size_t>(chunk_size, 1);
+
+  std::vector<std::future<std::vector<uint64_t>>> tasks;
+  for(size_t first = 0; first < size; first += chunk_size)
+  {
+    const size_t last = std::min(size, first + chunk_size);
+    const size_t search_last = std::min(size, last + overlap);
+
+    tasks.push_back(pool.submit([&searcher, data, first, last, search_last]() {
+      std::vector<uint64_t> found;
+      searcher.find_all(data + first, data + search_last,
+        [&found, data, last](const char * match) {
+          if( static_cast<size_t>(match - data) < last )
+            found.push_back(static_cast<uint64_t>(match - data));
+        }
+      );
+      return found;
+    }));
+  }
+
+  for(auto& task : tasks)
+    pool.wait(task);
+
+  for(auto& task : tasks)
+  {
+    const std::vector<uint64_t> found = task.get();
+    offsets.insert(offsets.end(), found.begin(), found.end());
+  }
+
+  return offsets;
+}
+
+// offsets of all occurrences in the file at path, ascending; throws
+// std::runtime_error if the file cannot be read
+template<typename searcher_type>
+std::vector<uint64_t> parallel_grep_file(
+  const searcher_type& searcher,
+  const std::string& path,
+  util::thread_pool& pool,
+  size_t chunk_size = 4 << 20
+)
+{
+  const util::mapped_file file(path);
+  return parallel_find_all(searcher, file.data(), file.size(), pool, chunk_size);
+}
+
+}
+
+#endif // AL_PARALLEL_GREP_H
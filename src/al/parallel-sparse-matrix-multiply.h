@@ -0,0 +1,194 @@
+#ifndef AL_PARALLEL_SPARSE_MATRIX_MULTIPLY_H
+#define AL_PARALLEL_SPARSE_MATRIX_MULTIPLY_H
+
+/*
+ * ds::sparse_matrix products computed as tasks on a util::thread_pool.
+ *
+ * The lines (rows for CSR, columns for CSC) of the left operand are split
+ * into ranges with about the same number of non-zeros, so tasks get about
+ * the same amount of work even if the non-zeros cluster in a few lines.
+ *
+ * A CSR matrix-vector product writes disjoint parts of the result. The
+ * columns of a CSC matrix scatter into all of the result instead, so every
+ * task accumulates into its own vector, and these are summed up at the end.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "ds/sparse-matrix.h"
+#include "util/thread-pool.h"
+
+namespace al {
+
+namespace mm {
+
+// Boundaries of at most num_parts line ranges with about the same number
+// of non-zeros: range i is [bounds[i], bounds[i + 1]).
+inline std::vector<size_t> balanced_line_ranges(
+  const std::vector<size_t>& offsets,
+  size_t num_parts
+)
+{
+  const size_t num_lines = offsets.size() - 1;
+  const size_t nonzeros = offsets.back();
+  num_parts = std::max<size_t>(1, std::min(num_parts, num_lines));
+
+  std::vector<size_t> bounds(1, 0);
+  for(size_t part = 1; part < num_parts; ++part)
+  {
+    // the first line starting at or after part / num_parts of the non-zeros
+    const size_t target = nonzeros * part / num_parts;
+    const size_t line = static_cast<size_t>(
+      std::lower_bound(offsets.begin(), offsets.end() - 1, target) -
+      offsets.begin()
+    );
+
+    if( line > bounds.back() )
+      bounds.push_back(line);
+  }
+  bounds.push_back(num_lines);
+
+  return bounds;
+}
+
+// waits for all tasks before the first exception is rethrown
+template<typename result_type>
+void wait_all(
+  util::thread_pool& pool,
+  std::vector<std::future<result_type>>& futures
+)
+{
+  for(auto& future : futures)
+    pool.wait(future);
+}
+
+}
+
+// matrix * x
+template<typename value_type>
+std::vector<value_type> parallel_sparse_matrix_vector_multiply(
+  const ds::sparse_matrix<value_type>& matrix,
+  const std::vector<value_type>& x,
+  util::thread_pool& pool
+)
+{
+  if( x.size() != matrix.get_cols() )
+    throw std::out_of_range("vector size differs from matrix cols, "
+      "parallel sparse matrix vector multiply impossible");
+
+  std::vector<value_type> y(matrix.get_rows(), value_type());
+
+  if( matrix.get_layout() == ds::matrix_layout::row_major )
+  {
+    // more ranges than threads, to even out differences in their runtime
+    const std::vector<size_t> bounds =
+      mm::balanced_line_ranges(matrix.get_offsets(), 4 * pool.size());
+
+    std::vector<std::future<void>> tasks;
+    for(size_t i = 0; i + 1 < bounds.size(); ++i)
+    {
+      const size_t first = bounds[i];
+      const size_t last = bounds[i + 1];
+      tasks.push_back(pool.submit([&matrix, &x, &y, first, last]() {
+        ds::detail::sparse_multiply_lines(
+          matrix, first, last, x.data(), y.data()
+        );
+      }));
+    }
+
+    mm::wait_all(pool, tasks);
+    for(auto& task : tasks)
+      task.get();
+
+    return y;
+  }
+
+  // one partial result per thread
+  const std::vector<size_t> bounds =
+    mm::balanced_line_ranges(matrix.get_offsets(), pool.size());
+
+  std::vector<std::future<std::vector<value_type>>> tasks;
+  for(size_t i = 0; i + 1 < bounds.size(); ++i)
+  {
+    const size_t first = bounds[i];
+    const size_t last = bounds[i + 1];
+    tasks.push_back(pool.submit([&matrix, &x, first, last]() {
+      std::vector<value_type> partial(matrix.get_rows(), value_type());
+      ds::detail::sparse_multiply_lines(
+        matrix, first, last, x.data(), partial.data()
+      );
+      return partial;
+    }));
+  }
+
+  mm::wait_all(pool, tasks);
+  for(auto& task : tasks)
+  {
+    const std::vector<value_type> partial = task.get();
+    for(size_t row = 0; row < y.size(); ++row)
+      y[row] += partial[row];
+  }
+
+  return y;
+}
+
+// left * right, the result has the layout of left
+template<typename value_type>
+ds::sparse_matrix<value_type> parallel_sparse_matrix_multiply(
+  const ds::sparse_matrix<value_type>& left,
+  const ds::sparse_matrix<value_type>& right,
+  util::thread_pool& pool
+)
+{
+  if( left.get_cols() != right.get_rows() )
+    throw std::out_of_range("inner matrix dimensions differ, "
+      "parallel sparse matrix multiply impossible");
+
+  if( right.get_layout() != left.get_layout() )
+  {
+    return parallel_sparse_matrix_multiply(
+      left, right.with_layout(left.get_layout()), pool
+    );
+  }
+
+  ds::sparse_matrix<value_type> result(
+    left.get_rows(), right.get_cols(), left.get_layout()
+  );
+
+  // the lines of the result are built from the lines of left (CSR) or
+  // right (CSC)
+  const ds::sparse_matrix<value_type>& outer =
+    left.get_layout() == ds::matrix_layout::row_major ? left : right;
+  const std::vector<size_t> bounds =
+    mm::balanced_line_ranges(outer.get_offsets(), 4 * pool.size());
+
+  std::vector<std::future<ds::detail::sparse_lines<value_type>>> tasks;
+  for(size_t i = 0; i + 1 < bounds.size(); ++i)
+  {
+    const size_t first = bounds[i];
+    const size_t last = bounds[i + 1];
+    tasks.push_back(pool.submit([&left, &right, first, last]() {
+      return ds::detail::sparse_multiply_lines(left, right, first, last);
+    }));
+  }
+
+  mm::wait_all(pool, tasks);
+
+  std::vector<ds::detail::sparse_lines<value_type>> parts;
+  parts.reserve(tasks.size());
+  for(auto& task : tasks)
+    parts.push_back(task.get());
+
+  result.assign_lines(parts);
+
+  return result;
+}
+
+}
+
+#endif // AL_PARALLEL_SPARSE_MATRIX_MULTIPLY_H
@@ -0,0 +1,216 @@
+#ifndef AL_PARALLEL_STRASSEN_MATRIX_MULTIPLY_H
+#define AL_PARALLEL_STRASSEN_MATRIX_MULTIPLY_H
+
+/*
+ * Strassen's algorithm with the seven sub-products of the topmost
+ * recursion levels computed as tasks on a util::thread_pool.
+ *
+ * Every parallel level submits 6 of the 7 products as tasks and computes
+ * the 7th itself, so parallel_depth levels yield 7^parallel_depth
+ * products computed concurrently; below that depth each continues with
+ * the sequential al::mm::strassen_recurse. The default depth of 3 (343
+ * products) keeps 32 cores busy without much load imbalance.
+ *
+ * Compared to the sequential recursion, a parallel level needs more
+ * scratch memory: all seven products and their operands exist at the
+ * same time (17 quadrants instead of 3).
+ *
+ */
+
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "al/strassen-matrix-multiply.h"
+#include "al/mm/matrix-view.h"
+#include "util/thread-pool.h"
+
+namespace al {
+
+const size_t strassen_parallel_depth = 3;
+
+namespace mm {
+
+// out = left * right, out must not alias left or right
+template<typename value_type>
+void parallel_strassen_recurse(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out,
+  util::thread_pool& pool,
+  size_t parallel_depth,
+  size_t crossover_width
+)
+{
+  typedef matrix_view<const value_type> in_view;
+  typedef matrix_view<value_type> out_view;
+
+  const size_t width = out.get_width();
+
+  if( parallel_depth == 0 || width <= crossover_width || width & 1 )
+  {
+    strassen_recurse<value_type>(left, right, out, crossover_width);
+    return;
+  }
+
+  const size_t half = width / 2;
+  const size_t depth = parallel_depth - 1;
+
+  const in_view A(left.quadrant(0));
+  const in_view B(left.quadrant(1));
+  const in_view C(left.quadrant(2));
+  const in_view D(left.quadrant(3));
+
+  const in_view E(right.quadrant(0));
+  const in_view F(right.quadrant(1));
+  const in_view G(right.quadrant(2));
+  const in_view H(right.quadrant(3));
+
+  // 7 products, 10 operand sums
+  std::vector<value_type> scratch(17 * half * half);
+  const auto block = [&](size_t index) {
+    return out_view(scratch.data() + index * half * half, half, half);
+  };
+
+  const out_view M1(block(0)), M2(block(1)), M3(block(2)), M4(block(3));
+  const out_view M5(block(4)), M6(block(5)), M7(block(6));
+
+  const out_view S1(block(7)), T1(block(8)), S2(block(9)), T3(block(10));
+  const out_view T4(block(11)), S5(block(12)), S6(block(13)), T6(block(14));
+  const out_view S7(block(15)), T7(block(16));
+
+  std::future<void> products[] = {
+    pool.submit([=, &pool]() {
+      add<value_type>(A, D, S1);
+      add<value_type>(E, H, T1);
+      parallel_strassen_recurse<value_type>(
+        S1, T1, M1, pool, depth, crossover_width
+      );
+    }),
+    pool.submit([=, &pool]() {
+      add<value_type>(C, D, S2);
+      parallel_strassen_recurse<value_type>(
+        S2, E, M2, pool, depth, crossover_width
+      );
+    }),
+    pool.submit([=, &pool]() {
+      subtract<value_type>(F, H, T3);
+      parallel_strassen_recurse<value_type>(
+        A, T3, M3, pool, depth, crossover_width
+      );
+    }),
+    pool.submit([=, &pool]() {
+      subtract<value_type>(G, E, T4);
+      parallel_strassen_recurse<value_type>(
+        D, T4, M4, pool, depth, crossover_width
+      );
+    }),
+    pool.submit([=, &pool]() {
+      add<value_type>(A, B, S5);
+      parallel_strassen_recurse<value_type>(
+        S5, H, M5, pool, depth, crossover_width
+      );
+    }),
+    pool.submit([=, &pool]() {
+      subtract<value_type>(C, A, S6);
+      add<value_type>(E, F, T6);
+      parallel_strassen_recurse<value_type>(
+        S6, T6, M6, pool, depth, crossover_width
+      );
+    })
+  };
+
+  // the calling thread computes the last product itself
+  std::exception_ptr error;
+  try
+  {
+    subtract<value_type>(B, D, S7);
+    add<value_type>(G, H, T7);
+    parallel_strassen_recurse<value_type>(
+      S7, T7, M7, pool, depth, crossover_width
+    );
+  }
+  catch(...)
+  {
+    error = std::current_exception();
+  }
+
+  // all tasks must be done before an exception may unwind scratch
+  for(auto& product : products)
+    pool.wait(product);
+
+  if( error )
+    std::rethrow_exception(error);
+
+  // rethrows exceptions of the tasks
+  for(auto& product : products)
+    product.get();
+
+  const out_view R1(out.quadrant(0));
+  const out_view R2(out.quadrant(1));
+  const out_view R3(out.quadrant(2));
+  const out_view R4(out.quadrant(3));
+
+  // R1 = M1 + M4 - M5 + M7
+  add<value_type>(M1, M4, R1);
+  subtract_from<value_type>(M5, R1);
+  add_to<value_type>(M7, R1);
+
+  // R2 = M3 + M5
+  add<value_type>(M3, M5, R2);
+
+  // R3 = M2 + M4
+  add<value_type>(M2, M4, R3);
+
+  // R4 = M1 - M2 + M3 + M6
+  subtract<value_type>(M1, M2, R4);
+  add_to<value_type>(M3, R4);
+  add_to<value_type>(M6, R4);
+}
+
+}
+
+template<typename square_matrix>
+square_matrix parallel_strassen_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  util::thread_pool& pool,
+  size_t parallel_depth = strassen_parallel_depth,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "parallel strassen matrix multiply impossible");
+  }
+
+  const size_t width = left.get_width();
+  square_matrix result(width);
+
+  mm::with_zero_padding<value_type>(
+    mm::matrix_view<const value_type>(left.raw_data(), width, width),
+    mm::matrix_view<const value_type>(right.raw_data(), width, width),
+    mm::matrix_view<value_type>(result.raw_data(), width, width),
+    mm::strassen_padded_width(width, crossover_width),
+    [&pool, parallel_depth, crossover_width](
+      mm::matrix_view<const value_type> l,
+      mm::matrix_view<const value_type> r,
+      mm::matrix_view<value_type> o
+    ) {
+      mm::parallel_strassen_recurse<value_type>(
+        l, r, o, pool, parallel_depth, crossover_width
+      );
+    }
+  );
+
+  return result;
+}
+
+}
+
+#endif // AL_PARALLEL_STRASSEN_MATRIX_MULTIPLY_H
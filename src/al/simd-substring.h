@@ -0,0 +1,281 @@
+#ifndef AL_SIMD_SUBSTRING_H
+#define AL_SIMD_SUBSTRING_H
+
+/*
+ * Substring search for byte strings with a vectorized filter, for short
+ * patterns where the shifts of boyer_moore_substring are too small to pay
+ * for its per-position work.
+ *
+ * The first and the last byte of the pattern are compared against 32 (AVX2)
+ * or 16 (SSE2) positions of the text at once: position i is a candidate
+ * only if text[i] == pattern[0] and text[i + len - 1] == pattern[len - 1].
+ * Only the candidates are compared with the rest of the pattern. Two bytes
+ * are far more selective than one, so in most texts only a few positions
+ * per block are candidates. On x86 the AVX2 kernel is chosen at runtime if
+ * the cpu supports it; elsewhere positions are filtered one at a time.
+ * Single byte patterns use memchr.
+ *
+ * The interface is that of boyer_moore_substring on const char *, so
+ * stream_searcher and parallel_find_all work with either.
+ *
+ * References:
+ * - Mula: SIMD-friendly algorithms for substring searching
+ *
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "util/cpu-features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__SSE2__)
+  #define AL_SIMD_SUBSTRING_X86 1
+  #include <immintrin.h>
+#else
+  #define AL_SIMD_SUBSTRING_X86 0
+#endif
+
+namespace al {
+
+namespace detail {
+
+// Calls on_match(pos) for the candidates pos in [first, last] whose first,
+// last and middle bytes match, until it returns true. Returns true if it
+// did. len >= 2.
+template<typename function>
+bool scalar_filter(
+  const char * text,
+  size_t first,
+  size_t last,
+  const char * pattern,
+  size_t len,
+  function& on_match
+)
+{
+  for(size_t pos = first; pos <= last; ++pos)
+  {
+    if( text[pos] == pattern[0] &&
+        text[pos + len - 1] == pattern[len - 1] &&
+        std::memcmp(text + pos + 1, pattern + 1, len - 2) == 0 &&
+        on_match(pos) )
+      return true;
+  }
+
+  return false;
+}
+
+#if AL_SIMD_SUBSTRING_X86
+
+// candidates of the bits of mask, positions base + bit
+template<typename function>
+inline __attribute__((always_inline)) bool verify_candidates(
+  unsigned int mask,
+  const char * text,
+  size_t base,
+  const char * pattern,
+  size_t len,
+  function& on_match
+)
+{
+  while( mask )
+  {
+    const size_t pos = base + static_cast<size_t>(__builtin_ctz(mask));
+    if( std::memcmp(text + pos + 1, pattern + 1, len - 2) == 0 &&
+        on_match(pos) )
+      return true;
+
+    mask &= mask - 1;
+  }
+
+  return false;
+}
+
+// The filter for blocks of 16 positions in [0, size - len]. Returns the
+// first position not filtered, or size if on_match returned true.
+template<typename function>
+size_t sse2_filter(
+  const char * text,
+  size_t size,
+  const char * pattern,
+  size_t len,
+  function& on_match
+)
+{
+  const __m128i first = _mm_set1_epi8(pattern[0]);
+  const __m128i last = _mm_set1_epi8(pattern[len - 1]);
+
+  size_t i = 0;
+  for(; i + len - 1 + 16 <= size; i += 16)
+  {
+    const __m128i block_first = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(text + i)
+    );
+    const __m128i block_last = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(text + i + len - 1)
+    );
+    const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(
+      _mm_and_si128(
+        _mm_cmpeq_epi8(first, block_first),
+        _mm_cmpeq_epi8(last, block_last)
+      )
+    ));
+
+    if( verify_candidates(mask, text, i, pattern, len, on_match) )
+      return size;
+  }
+
+  return i;
+}
+
+// the same for blocks of 32 positions
+template<typename function>
+__attribute__((target("avx2"))) size_t avx2_filter(
+  const char * text,
+  size_t size,
+  const char * pattern,
+  size_t len,
+  function& on_match
+)
+{
+  const __m256i first = _mm256_set1_epi8(pattern[0]);
+  const __m256i last = _mm256_set1_epi8(pattern[len - 1]);
+
+  size_t i = 0;
+  for(; i + len - 1 + 32 <= size; i += 32)
+  {
+    const __m256i block_first = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i *>(text + i)
+    );
+    const __m256i block_last = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i *>(text + i + len - 1)
+    );
+    const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(
+      _mm256_and_si256(
+        _mm256_cmpeq_epi8(first, block_first),
+        _mm256_cmpeq_epi8(last, block_last)
+      )
+    ));
+
+    if( verify_candidates(mask, text, i, pattern, len, on_match) )
+      return size;
+  }
+
+  return i;
+}
+
+#endif
+
+}
+
+class simd_substring
+{
+  public:
+    simd_substring(const char * begin, const char * end)
+    : pattern(begin, end)
+    {
+    }
+
+    // the first occurrence of the pattern, s_end if there is none
+    const char * strstr(const char * s_begin, const char * s_end) const
+    {
+      if( this->pattern.empty() )
+        return s_begin;
+
+      const char * found = s_end;
+      this->scan(s_begin, s_end, [&found, s_begin](size_t pos) {
+        found = s_begin + pos;
+        return true;
+      });
+
+      return found;
+    }
+
+    // Calls func(match) for every occurrence of the pattern, overlapping
+    // ones included, in order. An empty pattern has none.
+    template<typename function>
+    void find_all(const char * s_begin, const char * s_end, function func) const
+    {
+      if( this->pattern.empty() )
+        return;
+
+      this->scan(s_begin, s_end, [&func, s_begin](size_t pos) {
+        func(s_begin + pos);
+        return false;
+      });
+    }
+
+    std::vector<const char *> find_all(
+      const char * s_begin,
+      const char * s_end
+    ) const
+    {
+      std::vector<const char *> matches;
+      this->find_all(s_begin, s_end, [&matches](const char * match) {
+        matches.push_back(match);
+      });
+
+      return matches;
+    }
+
+    std::ptrdiff_t get_pattern_length() const
+    {
+      return static_cast<std::ptrdiff_t>(this->pattern.size());
+    }
+
+    // false if positions are filtered one at a time (no SSE2/AVX2)
+    static bool is_vectorized()
+    {
+      return AL_SIMD_SUBSTRING_X86 != 0;
+    }
+
+  private:
+    // on_match(pos) for every occurrence until it returns true;
+    // the pattern is not empty
+    template<typename function>
+    void scan(const char * s_begin, const char * s_end, function on_match) const
+    {
+      const size_t size = static_cast<size_t>(s_end - s_begin);
+      const size_t len = this->pattern.size();
+      const char * p = this->pattern.data();
+
+      if( len > size )
+        return;
+
+      if( len == 1 )
+      {
+        for(const char * it = s_begin;
+            (it = static_cast<const char *>(
+              std::memchr(it, p[0], static_cast<size_t>(s_end - it))
+            )) != nullptr;
+            ++it)
+        {
+          if( on_match(static_cast<size_t>(it - s_begin)) )
+            return;
+        }
+
+        return;
+      }
+
+      size_t first = 0;
+#if AL_SIMD_SUBSTRING_X86
+      if( util::cpu_has_avx2() )
+        first = detail::avx2_filter(s_begin, size, p, len, on_match);
+      else
+        first = detail::sse2_filter(s_begin, size, p, len, on_match);
+
+      if( first == size )
+        return;
+#endif
+
+      detail::scalar_filter(s_begin, first, size - len, p, len, on_match);
+    }
+
+    std::string pattern;
+};
+
+}
+
+#endif // AL_SIMD_SUBSTRING_H
@@ -0,0 +1,375 @@
+#ifndef AL_SMALL_MATRIX_MULTIPLY_H
+#define AL_SMALL_MATRIX_MULTIPLY_H
+
+/*
+ * Classical matrix multiplication of tiny matrices (up to
+ * small_matrix_max_width), e.g. the 4x4 transforms of graphics code.
+ *
+ * For these, the recursion of strassen_matrix_multiply and the packing of
+ * the blocked kernel cost more than the multiplication itself. Instead,
+ * every width gets its own kernel with the width as a template parameter,
+ * unrolled at compile time, which accumulates a row of the result in
+ * registers. With gcc and clang, when a row is a power of two bytes (e.g.
+ * 4, 8 or 16 floats), the row is a single vector type and the kernel is
+ * width vector multiply-adds per row; otherwise it is width * width scalar
+ * multiply-adds.
+ *
+ * batched_matrix_multiply multiplies many pairs of matrices of one width in
+ * one call: the kernel is chosen once for the batch, and the results can be
+ * written into the matrices of an earlier batch.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "al/mm/blocked-kernel.h"
+
+namespace al {
+
+// the largest width with an unrolled kernel
+const size_t small_matrix_max_width = 16;
+
+namespace mm {
+
+namespace detail {
+
+// calls func(std::integral_constant<size_t, i>()) for i in [0, count)
+template<size_t count>
+struct unroll
+{
+  template<typename function>
+  static void apply(function& func)
+  {
+    unroll<count - 1>::apply(func);
+    func(std::integral_constant<size_t, count - 1>());
+  }
+};
+
+template<>
+struct unroll<0>
+{
+  template<typename function>
+  static void apply(function&)
+  {
+  }
+};
+
+// a whole row of width elements fits a (gcc/clang) vector type of at most
+// 128 bytes, which the compiler splits into vector registers
+template<size_t width, typename value_type>
+struct has_row_vector
+: std::integral_constant<
+    bool,
+#if defined(__GNUC__)
+    std::is_arithmetic<value_type>::value &&
+    !std::is_same<value_type, bool>::value &&
+    !std::is_same<value_type, long double>::value &&
+    (width > 1) &&
+    ((width * sizeof(value_type)) & (width * sizeof(value_type) - 1)) == 0 &&
+    (width * sizeof(value_type) <= 128)
+#else
+    false
+#endif
+  >
+{};
+
+template<
+  size_t width,
+  typename value_type,
+  bool vectorized = has_row_vector<width, value_type>::value
+>
+struct small_kernel
+{
+  // acc[j] += factor * b_row[j]
+  struct scaled_row
+  {
+    value_type factor;
+    const value_type * b_row;
+    value_type * acc;
+
+    template<size_t j>
+    void operator()(std::integral_constant<size_t, j>)
+    {
+      this->acc[j] += this->factor * this->b_row[j];
+    }
+  };
+
+  // acc += a_row[k] * (row k of b)
+  struct row_product
+  {
+    const value_type * a_row;
+    const value_type * b;
+    value_type * acc;
+
+    template<size_t k>
+    void operator()(std::integral_constant<size_t, k>)
+    {
+      scaled_row step = { this->a_row[k], this->b + k * width, this->acc };
+      unroll<width>::apply(step);
+    }
+  };
+
+  // out = left * right, row-major width x width
+  static void multiply(
+    const value_type * left,
+    const value_type * right,
+    value_type * out
+  )
+  {
+    for(size_t i = 0; i < width; ++i)
+    {
+      value_type acc[width] = {};
+      row_product product = { left + i * width, right, acc };
+      unroll<width>::apply(product);
+
+      for(size_t j = 0; j < width; ++j)
+        out[i * width + j] = acc[j];
+    }
+  }
+};
+
+#if defined(__GNUC__)
+
+// the same with rows of b and the result as vectors: only the loop over k
+// needs unrolling
+template<size_t width, typename value_type>
+struct small_kernel<width, value_type, true>
+{
+  typedef value_type row
+    __attribute__((vector_size(width * sizeof(value_type))));
+
+  // acc += a_row[k] * (row k of b)
+  struct row_product
+  {
+    const value_type * a_row;
+    const value_type * b;
+    row * acc;
+
+    template<size_t k>
+    void operator()(std::integral_constant<size_t, k>)
+    {
+      // memcpy compiles to unaligned vector loads
+      row b_row;
+      std::memcpy(&b_row, this->b + k * width, sizeof(row));
+      *this->acc += b_row * this->a_row[k];
+    }
+  };
+
+  static void multiply(
+    const value_type * left,
+    const value_type * right,
+    value_type * out
+  )
+  {
+    for(size_t i = 0; i < width; ++i)
+    {
+      row acc = {};
+      row_product product = { left + i * width, right, &acc };
+      unroll<width>::apply(product);
+
+      std::memcpy(out + i * width, &acc, sizeof(row));
+    }
+  }
+};
+
+#endif
+
+// dispatches a runtime width to small_kernel<width> once for a batch of
+// count products, false if width is larger than max_width;
+// operands_of(i, left, right, out) sets the operands of the i-th product
+template<size_t max_width>
+struct small_dispatch
+{
+  template<typename value_type, typename operands>
+  static bool apply(size_t width, size_t count, operands& operands_of)
+  {
+    if( width != max_width )
+      return small_dispatch<max_width - 1>::template apply<value_type>(
+        width, count, operands_of
+      );
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      const value_type * left;
+      const value_type * right;
+      value_type * out;
+      operands_of(i, left, right, out);
+      small_kernel<max_width, value_type>::multiply(left, right, out);
+    }
+
+    return true;
+  }
+};
+
+template<>
+struct small_dispatch<0>
+{
+  template<typename value_type, typename operands>
+  static bool apply(size_t, size_t, operands&)
+  {
+    return false;
+  }
+};
+
+// count products of row-major width x width matrices, with the unrolled
+// kernel for width or else the blocked kernel
+template<typename value_type, typename operands>
+void multiply_batch(size_t width, size_t count, operands& operands_of)
+{
+  if( small_dispatch<small_matrix_max_width>::template apply<value_type>(
+        width, count, operands_of
+      ) )
+    return;
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    const value_type * left;
+    const value_type * right;
+    value_type * out;
+    operands_of(i, left, right, out);
+
+    std::fill(out, out + width * width, value_type());
+    blocked_multiply_add(
+      width, width, width, left, width, right, width, out, width
+    );
+  }
+}
+
+}
+
+// out[i] = left[i] * right[i] for count row-major width x width matrices
+// stored one after the other; out must not alias left or right
+template<typename value_type>
+void batched_multiply(
+  size_t width,
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t count
+)
+{
+  const size_t size = width * width;
+  auto operands_of = [=](
+    size_t i,
+    const value_type *& l,
+    const value_type *& r,
+    value_type *& o
+  ) {
+    l = left + i * size;
+    r = right + i * size;
+    o = out + i * size;
+  };
+
+  detail::multiply_batch<value_type>(width, count, operands_of);
+}
+
+}
+
+// classical matrix multiplication without any recursion or packing, for
+// matrices up to small_matrix_max_width; larger ones fall back to the
+// blocked kernel
+template<typename square_matrix>
+square_matrix small_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right
+)
+{
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "small matrix multiply impossible");
+  }
+
+  square_matrix result(left.get_width());
+  mm::batched_multiply(
+    left.get_width(), left.raw_data(), right.raw_data(), result.raw_data(), 1
+  );
+
+  return result;
+}
+
+// out[i] = left[i] * right[i] for pairs of small matrices of one width,
+// with the kernel chosen once for the whole batch. out is resized to the
+// batch; matrices of out which already have the width are reused, so a
+// batch multiplied again into the same out allocates nothing.
+template<typename square_matrix>
+void batched_matrix_multiply(
+  const std::vector<square_matrix>& left,
+  const std::vector<square_matrix>& right,
+  std::vector<square_matrix>& out
+)
+{
+  typedef typename std::remove_const<
+    typename std::remove_pointer<
+      decltype(std::declval<const square_matrix&>().raw_data())
+    >::type
+  >::type value_type;
+
+  if( left.size() != right.size() )
+  {
+    throw std::out_of_range("batch size differs, "
+      "batched matrix multiply impossible");
+  }
+
+  if( left.empty() )
+  {
+    out.clear();
+    return;
+  }
+
+  const size_t width = left[0].get_width();
+  for(size_t i = 0; i < left.size(); ++i)
+  {
+    if( left[i].get_width() != width || right[i].get_width() != width )
+    {
+      throw std::out_of_range("matrix width differs, "
+        "batched matrix multiply impossible");
+    }
+  }
+
+  if( out.size() > left.size() )
+    out.erase(out.begin() + static_cast<std::ptrdiff_t>(left.size()), out.end());
+  for(auto& matrix : out)
+  {
+    if( matrix.get_width() != width )
+      matrix = square_matrix(width);
+  }
+  while( out.size() < left.size() )
+    out.emplace_back(width);
+
+  auto operands_of = [&left, &right, &out](
+    size_t i,
+    const value_type *& l,
+    const value_type *& r,
+    value_type *& o
+  ) {
+    l = left[i].raw_data();
+    r = right[i].raw_data();
+    o = out[i].raw_data();
+  };
+
+  mm::detail::multiply_batch<value_type>(width, left.size(), operands_of);
+}
+
+// the products left[i] * right[i] of pairs of small matrices of one width
+template<typename square_matrix>
+std::vector<square_matrix> batched_matrix_multiply(
+  const std::vector<square_matrix>& left,
+  const std::vector<square_matrix>& right
+)
+{
+  std::vector<square_matrix> result;
+  batched_matrix_multiply(left, right, result);
+
+  return result;
+}
+
+}
+
+#endif // AL_SMALL_MATRIX_MULTIPLY_H
@@ -1,8 +1,16 @@
 #ifndef AL_STRASSEN_MATRIX_MULTIPLY_H
 #define AL_STRASSEN_MATRIX_MULTIPLY_H
 
+#include <algorithm>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "al/mm/blocked-kernel.h"
+#include "al/mm/elementwise.h"
+#include "al/mm/matrix-view.h"
+#include "al/mm/morton-layout.h"
 
 // forward declaration since ds/square-matrix.h references this file (avoid
 // chicken-egg problem)
@@ -13,57 +21,347 @@ namespace ds {
 
 namespace al {
 
+// at or below this width the classical blocked multiply takes over, because
+// it is faster than another level of recursion;
+// picked with test/benchmark (strassen-crossover)
+template<typename value_type>
+struct strassen_crossover : std::integral_constant<size_t, 64>
+{};
+
+template<>
+struct strassen_crossover<double> : std::integral_constant<size_t, 128>
+{};
+
+namespace mm {
+
+// out = left * right, out must not alias left or right
+template<typename value_type>
+void strassen_recurse(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out,
+  size_t crossover_width
+)
+{
+  typedef matrix_view<const value_type> in_view;
+  typedef matrix_view<value_type> out_view;
+
+  const size_t width = out.get_width();
+
+  if( width <= crossover_width || width & 1 )
+  {
+    fill(out, value_type());
+    blocked_multiply_add(
+      width, width, width,
+      left.data(), left.get_stride(),
+      right.data(), right.get_stride(),
+      out.data(), out.get_stride()
+    );
+    return;
+  }
+
+  const size_t half = width / 2;
+
+  const in_view A(left.quadrant(0));
+  const in_view B(left.quadrant(1));
+  const in_view C(left.quadrant(2));
+  const in_view D(left.quadrant(3));
+
+  const in_view E(right.quadrant(0));
+  const in_view F(right.quadrant(1));
+  const in_view G(right.quadrant(2));
+  const in_view H(right.quadrant(3));
+
+  const out_view R1(out.quadrant(0));
+  const out_view R2(out.quadrant(1));
+  const out_view R3(out.quadrant(2));
+  const out_view R4(out.quadrant(3));
+
+  // two operand sums and one product per level, instead of copies of all
+  // quadrants and a temporary for every intermediate result
+  std::vector<value_type> scratch(3 * half * half);
+  const out_view S(scratch.data(), half, half);
+  const out_view T(scratch.data() + half * half, half, half);
+  const out_view M(scratch.data() + 2 * half * half, half, half);
+
+  // strassen magic, each product is accumulated into the result quadrants
+  // right away:
+  // R1 = M1 + M4 - M5 + M7
+  // R2 = M3 + M5
+  // R3 = M2 + M4
+  // R4 = M1 - M2 + M3 + M6
+
+  // M1 = (A + D) * (E + H)
+  add<value_type>(A, D, S);
+  add<value_type>(E, H, T);
+  strassen_recurse<value_type>(S, T, R1, crossover_width);
+  copy<value_type>(R1, R4);
+
+  // M2 = (C + D) * E
+  add<value_type>(C, D, S);
+  strassen_recurse<value_type>(S, E, R3, crossover_width);
+  subtract_from<value_type>(R3, R4);
+
+  // M3 = A * (F - H)
+  subtract<value_type>(F, H, T);
+  strassen_recurse<value_type>(A, T, R2, crossover_width);
+  add_to<value_type>(R2, R4);
+
+  // M4 = D * (G - E)
+  subtract<value_type>(G, E, T);
+  strassen_recurse<value_type>(D, T, M, crossover_width);
+  add_to<value_type>(M, R1);
+  add_to<value_type>(M, R3);
+
+  // M5 = (A + B) * H
+  add<value_type>(A, B, S);
+  strassen_recurse<value_type>(S, H, M, crossover_width);
+  subtract_from<value_type>(M, R1);
+  add_to<value_type>(M, R2);
+
+  // M6 = (C - A) * (E + F)
+  subtract<value_type>(C, A, S);
+  add<value_type>(E, F, T);
+  strassen_recurse<value_type>(S, T, M, crossover_width);
+  add_to<value_type>(M, R4);
+
+  // M7 = (B - D) * (G + H)
+  subtract<value_type>(B, D, S);
+  add<value_type>(G, H, T);
+  strassen_recurse<value_type>(S, T, M, crossover_width);
+  add_to<value_type>(M, R1);
+}
+
+// out = left * right on matrices in Morton layout (see
+// al/mm/morton-layout.h) with tiles of leaf_width, out must not alias left
+// or right. Every quadrant is a contiguous block, so all sums are single
+// vectorized loops and the leaves are tight row-major tiles.
+template<typename value_type>
+void morton_strassen_recurse(
+  const value_type * left,
+  const value_type * right,
+  value_type * out,
+  size_t width,
+  size_t leaf_width
+)
+{
+  if( width <= leaf_width )
+  {
+    std::fill(out, out + width * width, value_type());
+    blocked_multiply_add(
+      width, width, width, left, width, right, width, out, width
+    );
+    return;
+  }
+
+  const size_t half = width / 2;
+  const size_t size = half * half;
+
+  const value_type * A = left;
+  const value_type * B = left + size;
+  const value_type * C = left + 2 * size;
+  const value_type * D = left + 3 * size;
+
+  const value_type * E = right;
+  const value_type * F = right + size;
+  const value_type * G = right + 2 * size;
+  const value_type * H = right + 3 * size;
+
+  value_type * R1 = out;
+  value_type * R2 = out + size;
+  value_type * R3 = out + 2 * size;
+  value_type * R4 = out + 3 * size;
+
+  std::vector<value_type> scratch(3 * size);
+  value_type * S = scratch.data();
+  value_type * T = scratch.data() + size;
+  value_type * M = scratch.data() + 2 * size;
+
+  // same schedule as strassen_recurse
+  elementwise::add(A, D, S, size);
+  elementwise::add(E, H, T, size);
+  morton_strassen_recurse(S, T, R1, half, leaf_width);
+  elementwise::copy(R1, R4, size);
+
+  elementwise::add(C, D, S, size);
+  morton_strassen_recurse(S, E, R3, half, leaf_width);
+  elementwise::subtract(R4, R3, R4, size);
+
+  elementwise::subtract(F, H, T, size);
+  morton_strassen_recurse(A, T, R2, half, leaf_width);
+  elementwise::add(R4, R2, R4, size);
+
+  elementwise::subtract(G, E, T, size);
+  morton_strassen_recurse(D, T, M, half, leaf_width);
+  elementwise::add(R1, M, R1, size);
+  elementwise::add(R3, M, R3, size);
+
+  elementwise::add(A, B, S, size);
+  morton_strassen_recurse(S, H, M, half, leaf_width);
+  elementwise::subtract(R1, M, R1, size);
+  elementwise::add(R2, M, R2, size);
+
+  elementwise::subtract(C, A, S, size);
+  elementwise::add(E, F, T, size);
+  morton_strassen_recurse(S, T, M, half, leaf_width);
+  elementwise::add(R4, M, R4, size);
+
+  elementwise::subtract(B, D, S, size);
+  elementwise::add(G, H, T, size);
+  morton_strassen_recurse(S, T, M, half, leaf_width);
+  elementwise::add(R1, M, R1, size);
+}
+
+// The smallest width >= width that can be halved down to the crossover
+// width without ever hitting an odd width. Pads to a multiple of the leaf
+// width instead of the next power of two, e.g. 1025 with crossover 64 halves
+// 5 times to leaves of width 33, the padded width is 33 * 32 = 1056.
+inline size_t strassen_padded_width(size_t width, size_t crossover_width)
+{
+  const size_t leaf_width = std::max<size_t>(crossover_width, 1);
+
+  size_t levels = 0;
+  size_t leaf = width;
+  while( leaf > leaf_width )
+  {
+    // round up, the padding is distributed over all levels
+    leaf = (leaf + 1) / 2;
+    ++levels;
+  }
+
+  return leaf << levels;
+}
+
+// Calls recurse(left, right, out) on copies of left and right, zero padded
+// to padded_width, and copies the top left of the product into out.
+// Without padding, recurse works directly on left, right and out.
+template<typename value_type, typename recurse_function>
+void with_zero_padding(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out,
+  size_t padded_width,
+  recurse_function recurse
+)
+{
+  typedef matrix_view<value_type> out_view;
+
+  const size_t width = out.get_width();
+  if( padded_width == width )
+  {
+    recurse(left, right, out);
+    return;
+  }
+
+  const size_t padded_size = padded_width * padded_width;
+  std::vector<value_type> buffer(3 * padded_size, value_type());
+
+  const out_view padded_left(buffer.data(), padded_width, padded_width);
+  const out_view padded_right(
+    buffer.data() + padded_size, padded_width, padded_width
+  );
+  const out_view padded_out(
+    buffer.data() + 2 * padded_size, padded_width, padded_width
+  );
+
+  // the top left width x width window of each padded matrix
+  copy<value_type>(left, out_view(padded_left.data(), width, padded_width));
+  copy<value_type>(right, out_view(padded_right.data(), width, padded_width));
+
+  recurse(padded_left, padded_right, padded_out);
+
+  copy<value_type>(out_view(padded_out.data(), width, padded_width), out);
+}
+
+}
+
 template<typename square_matrix>
 square_matrix strassen_matrix_multiply(
-  const square_matrix& left, 
-  const square_matrix& right
+  const square_matrix& left,
+  const square_matrix& right,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
 )
 {
+  typedef typename square_matrix::container::value_type value_type;
+
   if( left.get_width() != right.get_width() )
   {
     throw std::out_of_range("matrix width differs, "
       "strassen matrix multiply impossible");
   }
-  
-  if( left.get_width() < 2 )
+
+  const size_t width = left.get_width();
+  square_matrix result(width);
+
+  // the recursion works on views into the quadrants of left, right and
+  // result; nothing is split or combined
+  mm::with_zero_padding<value_type>(
+    mm::matrix_view<const value_type>(left.raw_data(), width, width),
+    mm::matrix_view<const value_type>(right.raw_data(), width, width),
+    mm::matrix_view<value_type>(result.raw_data(), width, width),
+    mm::strassen_padded_width(width, crossover_width),
+    [crossover_width](
+      mm::matrix_view<const value_type> l,
+      mm::matrix_view<const value_type> r,
+      mm::matrix_view<value_type> o
+    ) {
+      mm::strassen_recurse<value_type>(l, r, o, crossover_width);
+    }
+  );
+
+  return result;
+}
+
+// Like strassen_matrix_multiply, but the operands are first copied into the
+// Morton layout of al/mm/morton-layout.h (which also pads them), so every
+// recursion level works on contiguous quadrants; the product is copied back
+// at the end. Pays off for large matrices.
+template<typename square_matrix>
+square_matrix morton_strassen_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+
+  if( left.get_width() != right.get_width() )
   {
-    square_matrix matrix(1);
-    matrix.set(0, 0, left.get(0, 0) * right.get(0, 0));
-    return matrix;
+    throw std::out_of_range("matrix width differs, "
+      "morton strassen matrix multiply impossible");
   }
-  
-  // implement zero padding for matrices whose width is not a power of two
-
-  // split each matrix into 4 squares
-  typename square_matrix::split_result 
-    left_split(left.square_split());
-  typename square_matrix::split_result 
-    right_split(right.square_split());
-
-  const square_matrix& A(left_split[0]);
-  const square_matrix& B(left_split[1]);
-  const square_matrix& C(left_split[2]);
-  const square_matrix& D(left_split[3]);
-
-  const square_matrix& E(right_split[0]);
-  const square_matrix& F(right_split[1]);
-  const square_matrix& G(right_split[2]);
-  const square_matrix& H(right_split[3]);
-
-  // strassen magic
-  const square_matrix M1((A + D) * (E + H));
-  const square_matrix M2((C + D) * E);
-  const square_matrix M3(A * (F - H));
-  const square_matrix M4(D * (G - E));
-  const square_matrix M5((A + B) * H);
-  const square_matrix M6((C - A) * (E + F));
-  const square_matrix M7((B - D) * (G + H));
-
-  const square_matrix result(
-      M1 + M4 - M5 + M7,
-      M3 + M5,
-      M2 + M4,
-      M1 - M2 + M3 + M6
+
+  const size_t width = left.get_width();
+  const size_t padded_width = mm::strassen_padded_width(width, crossover_width);
+  const size_t leaf_width = mm::morton_leaf_width(padded_width, crossover_width);
+  const size_t padded_size = padded_width * padded_width;
+
+  std::vector<value_type> buffer(3 * padded_size);
+  value_type * morton_left = buffer.data();
+  value_type * morton_right = buffer.data() + padded_size;
+  value_type * morton_out = buffer.data() + 2 * padded_size;
+
+  mm::to_morton<value_type>(
+    mm::matrix_view<const value_type>(left.raw_data(), width, width),
+    morton_left, padded_width, leaf_width
+  );
+  mm::to_morton<value_type>(
+    mm::matrix_view<const value_type>(right.raw_data(), width, width),
+    morton_right, padded_width, leaf_width
+  );
+
+  mm::morton_strassen_recurse<value_type>(
+    morton_left, morton_right, morton_out, padded_width, leaf_width
+  );
+
+  square_matrix result(width);
+  mm::from_morton<value_type>(
+    morton_out,
+    mm::matrix_view<value_type>(result.raw_data(), width, width),
+    padded_width,
+    leaf_width
   );
 
   return result;
@@ -0,0 +1,153 @@
+#ifndef AL_STREAM_SEARCHER_H
+#define AL_STREAM_SEARCHER_H
+
+/*
+ * Finds all occurrences of a pattern in input that arrives in chunks (e.g.
+ * read from a pipe), without ever holding more than one chunk.
+ *
+ * An occurrence may straddle chunks. Of the previous chunks, only the last
+ * pattern length - 1 characters are kept (the overlap): the overlap plus
+ * the first pattern length - 1 characters of the next chunk are searched
+ * for occurrences starting in the overlap, then the chunk itself is
+ * searched in place. Offsets of occurrences are counted from the start of
+ * the whole input.
+ *
+ * searcher_type is e.g. al::boyer_moore_substring<const char *>, anything
+ * with get_pattern_length() and find_all(begin, end, func) on pointers.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+namespace al {
+
+template<typename searcher_type, typename char_type = char>
+class stream_searcher
+{
+  public:
+    // searcher must outlive the stream_searcher
+    explicit stream_searcher(const searcher_type& pattern_searcher)
+    : searcher(pattern_searcher),
+      overlap_len(pattern_searcher.get_pattern_length() > 0 ?
+        static_cast<size_t>(pattern_searcher.get_pattern_length()) - 1 : 0),
+      overlap(),
+      joint(),
+      consumed(0)
+    {
+      this->overlap.reserve(this->overlap_len);
+      this->joint.reserve(2 * this->overlap_len);
+    }
+
+    // Searches the next size characters of the input, calls
+    // func(uint64_t offset) for every occurrence which ends in them.
+    template<typename function>
+    void feed(const char_type * data, size_t size, function func)
+    {
+      if( size == 0 )
+        return;
+
+      if( this->overlap_len == 0 )
+      {
+        // single characters never straddle chunks
+        this->search(data, size, this->consumed, size, func);
+        this->consumed += size;
+        return;
+      }
+
+      // occurrences starting in the overlap
+      if( !this->overlap.empty() )
+      {
+        const size_t head = std::min(size, this->overlap_len);
+        this->joint.assign(this->overlap.begin(), this->overlap.end());
+        this->joint.insert(this->joint.end(), data, data + head);
+
+        const uint64_t joint_offset = this->consumed - this->overlap.size();
+        this->search(
+          this->joint.data(), this->joint.size(), joint_offset,
+          this->overlap.size(), func
+        );
+      }
+
+      this->search(data, size, this->consumed, size, func);
+      this->consumed += size;
+
+      // the new overlap: the last overlap_len characters of all input
+      if( size >= this->overlap_len )
+      {
+        this->overlap.assign(data + (size - this->overlap_len), data + size);
+      }
+      else
+      {
+        this->overlap.insert(this->overlap.end(), data, data + size);
+        this->overlap.erase(
+          this->overlap.begin(),
+          this->overlap.end() - static_cast<std::ptrdiff_t>(
+            std::min(this->overlap.size(), this->overlap_len)
+          )
+        );
+      }
+    }
+
+    // the number of characters fed so far
+    uint64_t get_consumed() const
+    {
+      return this->consumed;
+    }
+
+  private:
+    // occurrences in [data, data + size) starting before max_start,
+    // reported at base + their index
+    template<typename function>
+    void search(
+      const char_type * data,
+      size_t size,
+      uint64_t base,
+      size_t max_start,
+      function& func
+    ) const
+    {
+      this->searcher.find_all(data, data + size,
+        [data, base, max_start, &func](const char_type * match) {
+          const size_t index = static_cast<size_t>(match - data);
+          if( index < max_start )
+            func(base + index);
+        }
+      );
+    }
+
+    const searcher_type& searcher;
+    size_t overlap_len;
+    std::vector<char_type> overlap;
+    std::vector<char_type> joint;
+    uint64_t consumed;
+};
+
+// Reads in until its end in chunks of chunk_size, calls func(uint64_t
+// offset) for every occurrence; returns the number of characters read.
+template<typename searcher_type, typename function>
+uint64_t stream_search(
+  const searcher_type& searcher,
+  std::istream& in,
+  function func,
+  size_t chunk_size = 1 << 16
+)
+{
+  stream_searcher<searcher_type> stream(searcher);
+  std::vector<char> chunk(std::max<size_t>(chunk_size, 1));
+
+  while( in )
+  {
+    in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    stream.feed(chunk.data(), static_cast<size_t>(in.gcount()), func);
+  }
+
+  return stream.get_consumed();
+}
+
+}
+
+#endif // AL_STREAM_SEARCHER_H
@@ -0,0 +1,178 @@
+#ifndef AL_SUBSTRING_SEARCH_H
+#define AL_SUBSTRING_SEARCH_H
+
+/*
+ * A byte string searcher with the algorithm chosen by the pattern:
+ *
+ * - simd (al/simd-substring.h) where it is vectorized, for all patterns
+ *   but long ones over small alphabets: it filters 16 or 32 positions per
+ *   step, faster than any skip loop on text, and its setup is a copy
+ * - boyer_moore for long patterns (>= 16) over small alphabets (<= 4
+ *   distinct bytes, e.g. DNA), where first and last byte match too often
+ *   for the filter and the good suffix rule gives long shifts
+ * - otherwise sunday for short patterns (< 8), where its shift of up to
+ *   length + 1 gains most, and horspool for longer ones; neither needs the
+ *   good suffix table, which dominates the setup of one-off searches
+ *
+ * two_way (al/two-way-substring.h) is never chosen by the pattern, but
+ * may be asked for: it is the only one in O(n + m) for every text, so it
+ * suits patterns and texts from untrusted input.
+ *
+ * test/benchmark (substring-selection) compares the algorithms by pattern
+ * length, for one-off searches and repeated searches.
+ *
+ * Like boyer_moore_substring, and unlike the other searchers it wraps,
+ * substring_searcher owns a copy of the pattern.
+ *
+ */
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "al/boyer-moore-substring.h"
+#include "al/horspool-substring.h"
+#include "al/simd-substring.h"
+#include "al/sunday-substring.h"
+#include "al/two-way-substring.h"
+
+namespace al {
+
+enum class substring_algorithm
+{
+  boyer_moore,
+  horspool,
+  sunday,
+  simd,
+  two_way
+};
+
+inline substring_algorithm choose_substring_algorithm(
+  const char * p_begin,
+  const char * p_end
+)
+{
+  const size_t len = static_cast<size_t>(p_end - p_begin);
+
+  std::array<bool, 256> seen;
+  seen.fill(false);
+  size_t alphabet = 0;
+  for(const char * it = p_begin; it != p_end; ++it)
+  {
+    bool& byte_seen = seen[static_cast<unsigned char>(*it)];
+    alphabet += !byte_seen;
+    byte_seen = true;
+  }
+
+  if( len >= 16 && alphabet <= 4 )
+    return substring_algorithm::boyer_moore;
+
+  if( simd_substring::is_vectorized() )
+    return substring_algorithm::simd;
+
+  return len < 8 ? substring_algorithm::sunday : substring_algorithm::horspool;
+}
+
+class substring_searcher
+{
+  public:
+    typedef const char * iter;
+
+    substring_searcher(iter begin, iter end)
+    : substring_searcher(begin, end, choose_substring_algorithm(begin, end))
+    {
+    }
+
+    substring_searcher(iter begin, iter end, substring_algorithm algo)
+    : algorithm(algo),
+      pattern(begin, end),
+      boyer_moore(),
+      horspool(),
+      sunday(),
+      simd(),
+      two_way()
+    {
+      const iter p_begin = this->pattern.data();
+      const iter p_end = p_begin + this->pattern.size();
+
+      if( algo == substring_algorithm::boyer_moore )
+        this->boyer_moore.reset(
+          new boyer_moore_substring<iter>(p_begin, p_end)
+        );
+      else if( algo == substring_algorithm::horspool )
+        this->horspool.reset(new horspool_substring<iter>(p_begin, p_end));
+      else if( algo == substring_algorithm::sunday )
+        this->sunday.reset(new sunday_substring<iter>(p_begin, p_end));
+      else if( algo == substring_algorithm::two_way )
+        this->two_way.reset(new two_way_substring<iter>(p_begin, p_end));
+      else
+        this->simd.reset(new simd_substring(p_begin, p_end));
+    }
+
+    // the first occurrence of the pattern, s_end if there is none
+    iter strstr(iter s_begin, iter s_end) const
+    {
+      if( this->boyer_moore )
+        return this->boyer_moore->strstr(s_begin, s_end);
+      if( this->horspool )
+        return this->horspool->strstr(s_begin, s_end);
+      if( this->sunday )
+        return this->sunday->strstr(s_begin, s_end);
+      if( this->two_way )
+        return this->two_way->strstr(s_begin, s_end);
+
+      return this->simd->strstr(s_begin, s_end);
+    }
+
+    // Calls func(match) for every occurrence of the pattern, overlapping
+    // ones included, in order. An empty pattern has none.
+    template<typename function>
+    void find_all(iter s_begin, iter s_end, function func) const
+    {
+      if( this->boyer_moore )
+        this->boyer_moore->find_all(s_begin, s_end, func);
+      else if( this->horspool )
+        this->horspool->find_all(s_begin, s_end, func);
+      else if( this->sunday )
+        this->sunday->find_all(s_begin, s_end, func);
+      else if( this->two_way )
+        this->two_way->find_all(s_begin, s_end, func);
+      else
+        this->simd->find_all(s_begin, s_end, func);
+    }
+
+    std::vector<iter> find_all(iter s_begin, iter s_end) const
+    {
+      std::vector<iter> matches;
+      this->find_all(s_begin, s_end, [&matches](iter match) {
+        matches.push_back(match);
+      });
+
+      return matches;
+    }
+
+    std::ptrdiff_t get_pattern_length() const
+    {
+      return static_cast<std::ptrdiff_t>(this->pattern.size());
+    }
+
+    substring_algorithm get_algorithm() const
+    {
+      return this->algorithm;
+    }
+
+  private:
+    substring_algorithm algorithm;
+    // owned here, moving the searcher keeps the buffer in place
+    std::vector<char> pattern;
+    std::unique_ptr<boyer_moore_substring<iter>> boyer_moore;
+    std::unique_ptr<horspool_substring<iter>> horspool;
+    std::unique_ptr<sunday_substring<iter>> sunday;
+    std::unique_ptr<simd_substring> simd;
+    std::unique_ptr<two_way_substring<iter>> two_way;
+};
+
+}
+
+#endif // AL_SUBSTRING_SEARCH_H
@@ -0,0 +1,91 @@
+#ifndef AL_SUNDAY_SUBSTRING_H
+#define AL_SUNDAY_SUBSTRING_H
+
+// Sunday's quick search: like Horspool, but the shift is taken from the
+// character right after the window, which is never part of the current
+// attempt, so shifts can be up to pattern length + 1. The window is
+// compared from the front.
+//
+// http://www.iti.fh-flensburg.de/lang/algorithmen/pattern/sundayen.htm
+
+#include <algorithm>
+#include <iterator>
+
+#include "bm/default-skip-table.h"
+#include "bm/searcher-base.h"
+
+namespace al
+{
+
+template<
+  typename p_iter,
+  typename p_diff_type = typename std::iterator_traits<p_iter>::difference_type,
+  typename p_char_type = typename std::iterator_traits<p_iter>::value_type,
+  typename table_type =
+    typename bm::default_skip_table<p_char_type, p_diff_type>::type
+>
+class sunday_substring
+: public bm::searcher_base<
+    sunday_substring<p_iter, p_diff_type, p_char_type, table_type>,
+    p_diff_type,
+    p_char_type
+  >
+{
+  public:
+    sunday_substring(p_iter begin, p_iter end)
+    : searcher_base(std::distance(begin, end)),
+      p_begin(begin),
+      p_end(end),
+      skip(this->pattern_len, this->pattern_len + 1)
+    {
+      // the distance of the last occurrence of each character to the
+      // position after the pattern
+      p_diff_type i = 0;
+      for(p_iter it = begin; it != end; ++it, ++i)
+        this->skip.set(*it, this->pattern_len - i);
+    }
+
+  private:
+    typedef bm::searcher_base<
+      sunday_substring, p_diff_type, p_char_type
+    > searcher_base;
+    friend searcher_base;
+
+    const p_iter p_begin;
+    const p_iter p_end;
+    table_type skip;
+
+    // on_match(match) for every occurrence until it returns true;
+    // the pattern is not empty
+    template<typename s_iter, typename function>
+    void scan(s_iter s_begin, s_iter s_end, function on_match) const
+    {
+      if( std::distance(s_begin, s_end) < this->pattern_len )
+        return;
+
+      s_iter current = s_begin;
+      s_iter last = s_end - this->pattern_len;
+
+      while( true )
+      {
+        if( std::equal(this->p_begin, this->p_end, current) &&
+            on_match(current) )
+          return;
+
+        // there is no character after the last window
+        if( current == last )
+          return;
+
+        // not past last, the window would leave the text
+        const p_diff_type shift = this->skip.get(current[this->pattern_len]);
+        if( std::distance(current, last) < shift )
+          return;
+
+        current += shift;
+      }
+    }
+};
+
+}
+
+#endif // AL_SUNDAY_SUBSTRING_H
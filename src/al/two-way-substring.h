@@ -0,0 +1,193 @@
+#ifndef AL_TWO_WAY_SUBSTRING_H
+#define AL_TWO_WAY_SUBSTRING_H
+
+// Two-Way string matching (Crochemore, Perrin): O(n + m) comparisons in
+// the worst case with O(1) extra space, for patterns or texts that may be
+// adversarial. boyer_moore_substring, horspool_substring and
+// sunday_substring are faster on typical text, but take O(n * m) on e.g.
+// aaa...a in aaa...a.
+//
+// The pattern is split at a critical factorization x = u v, computed from
+// the maximal suffixes for both orders of the alphabet. v is compared
+// from left to right; on a mismatch the window shifts past the compared
+// characters. Then u is compared from right to left; on a mismatch (or
+// after a match) the window shifts by the period. For periodic patterns,
+// the prefix known to match after shifting by the period is remembered,
+// so no text character is compared twice in v.
+//
+// http://www-igm.univ-mlv.fr/~lecroq/string/node26.html
+
+#include <algorithm>
+#include <iterator>
+
+#include "bm/searcher-base.h"
+
+namespace al
+{
+
+template<
+  typename p_iter,
+  typename p_diff_type = typename std::iterator_traits<p_iter>::difference_type,
+  typename p_char_type = typename std::iterator_traits<p_iter>::value_type
+>
+class two_way_substring
+: public bm::searcher_base<
+    two_way_substring<p_iter, p_diff_type, p_char_type>,
+    p_diff_type,
+    p_char_type
+  >
+{
+  public:
+    two_way_substring(p_iter begin, p_iter end)
+    : searcher_base(std::distance(begin, end)),
+      p_begin(begin),
+      critical(-1),
+      period(1),
+      periodic(false)
+    {
+      if( this->pattern_len > 0 )
+        this->factorize();
+    }
+
+  private:
+    typedef bm::searcher_base<
+      two_way_substring, p_diff_type, p_char_type
+    > searcher_base;
+    friend searcher_base;
+
+    const p_iter p_begin;
+    // the last index of u in x = u v, -1 if u is empty
+    p_diff_type critical;
+    // the period of x if periodic, else a lower bound of it
+    p_diff_type period;
+    bool periodic;
+
+    // The start - 1 of the maximal suffix of the pattern, and its period,
+    // for the order of p_char_type (or its reverse if reversed).
+    p_diff_type maximal_suffix(bool reversed, p_diff_type& suffix_period) const
+    {
+      p_diff_type start = -1;
+      p_diff_type j = 0;
+      p_diff_type k = 1;
+      suffix_period = 1;
+
+      while( j + k < this->pattern_len )
+      {
+        const p_char_type a = this->p_begin[j + k];
+        const p_char_type b = this->p_begin[start + k];
+
+        if( reversed ? (b < a) : (a < b) )
+        {
+          j += k;
+          k = 1;
+          suffix_period = j - start;
+        }
+        else if( a == b )
+        {
+          if( k != suffix_period )
+          {
+            ++k;
+          }
+          else
+          {
+            j += suffix_period;
+            k = 1;
+          }
+        }
+        else
+        {
+          start = j;
+          j = start + 1;
+          k = suffix_period = 1;
+        }
+      }
+
+      return start;
+    }
+
+    void factorize()
+    {
+      p_diff_type p, q;
+      const p_diff_type i = this->maximal_suffix(false, p);
+      const p_diff_type j = this->maximal_suffix(true, q);
+
+      if( i > j )
+      {
+        this->critical = i;
+        this->period = p;
+      }
+      else
+      {
+        this->critical = j;
+        this->period = q;
+      }
+
+      // x is periodic with the period of v iff u is a suffix of v's prefix
+      this->periodic = std::equal(
+        this->p_begin,
+        this->p_begin + (this->critical + 1),
+        this->p_begin + this->period
+      );
+
+      if( !this->periodic )
+      {
+        this->period = std::max(
+          this->critical + 1, this->pattern_len - this->critical - 1
+        ) + 1;
+      }
+    }
+
+    // on_match(match) for every occurrence until it returns true;
+    // the pattern is not empty
+    template<typename s_iter, typename function>
+    void scan(s_iter s_begin, s_iter s_end, function on_match) const
+    {
+      typedef typename std::iterator_traits<s_iter>::difference_type s_diff_type;
+
+      const s_diff_type str_len = std::distance(s_begin, s_end);
+      if( str_len < this->pattern_len )
+        return;
+
+      const p_diff_type m = this->pattern_len;
+      const p_diff_type ell = this->critical;
+      const s_diff_type last = str_len - m;
+
+      // the length - 1 of the prefix of the pattern known to match the
+      // window, -1 if none
+      p_diff_type memory = -1;
+      s_diff_type j = 0;
+
+      while( j <= last )
+      {
+        s_iter window = s_begin + j;
+
+        // v, left to right
+        p_diff_type i = std::max(ell, memory) + 1;
+        while( i < m && this->p_begin[i] == window[i] )
+          ++i;
+
+        if( i < m )
+        {
+          j += i - ell;
+          memory = -1;
+          continue;
+        }
+
+        // u, right to left, down to the remembered prefix
+        i = ell;
+        while( i > memory && this->p_begin[i] == window[i] )
+          --i;
+
+        if( i <= memory && on_match(window) )
+          return;
+
+        j += this->period;
+        if( this->periodic )
+          memory = m - this->period - 1;
+      }
+    }
+};
+
+}
+
+#endif // AL_TWO_WAY_SUBSTRING_H
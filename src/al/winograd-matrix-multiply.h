@@ -0,0 +1,249 @@
+#ifndef AL_WINOGRAD_MATRIX_MULTIPLY_H
+#define AL_WINOGRAD_MATRIX_MULTIPLY_H
+
+/*
+ * The Winograd variant of Strassen's algorithm: 7 multiplications like
+ * Strassen's, but 15 additions per level instead of 18.
+ *
+ * The recursion needs two temporaries per level, X (for sums of the left
+ * quadrants) and Y (for sums of the right quadrants); everything else is
+ * computed in the quadrants of the result (schedule of Douglas et al.).
+ * Since one level runs at a time, the temporaries of all levels fit in a
+ * single workspace of 2 * (n/2)^2 + 2 * (n/4)^2 + ... < 2/3 n^2 elements,
+ * which is allocated once instead of on every level. If the width needs
+ * zero padding, the padded copies of both operands and of the product
+ * (3 * padded^2 elements) are kept at the front of the same workspace, so
+ * a multiplication allocates nothing but its result. Callers that multiply
+ * repeatedly can hand in their own workspace to reuse it.
+ *
+ * References:
+ * - Douglas, Heroux, Slishman, Smith: GEMMW: A Portable Level 3 BLAS
+ *   Winograd Variant of Strassen's Matrix-Matrix Multiply Algorithm
+ * - Boyer, Dumas, Pernet, Zhou: Memory efficient scheduling of
+ *   Strassen-Winograd's matrix multiplication algorithm
+ *
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "al/strassen-matrix-multiply.h"
+#include "al/mm/blocked-kernel.h"
+#include "al/mm/matrix-view.h"
+
+namespace al {
+
+namespace mm {
+
+// number of elements of the workspace of winograd_recurse
+inline size_t winograd_workspace_size(size_t width, size_t crossover_width)
+{
+  size_t size = 0;
+  while( width > crossover_width && !(width & 1) )
+  {
+    width /= 2;
+    size += 2 * width * width;
+  }
+
+  return size;
+}
+
+// number of elements of the workspace of winograd_matrix_multiply for
+// width x width operands: the workspace of winograd_recurse for the padded
+// width, plus the padded operands and product if the width needs padding
+inline size_t winograd_multiply_workspace_size(
+  size_t width,
+  size_t crossover_width
+)
+{
+  const size_t padded_width = strassen_padded_width(width, crossover_width);
+  const size_t padding_size =
+    padded_width == width ? 0 : 3 * padded_width * padded_width;
+
+  return padding_size + winograd_workspace_size(padded_width, crossover_width);
+}
+
+// out = left * right, out must not alias left or right; workspace must
+// hold winograd_workspace_size(width, crossover_width) elements
+template<typename value_type>
+void winograd_recurse(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out,
+  value_type * workspace,
+  size_t crossover_width
+)
+{
+  typedef matrix_view<const value_type> in_view;
+  typedef matrix_view<value_type> out_view;
+
+  const size_t width = out.get_width();
+
+  if( width <= crossover_width || width & 1 )
+  {
+    fill(out, value_type());
+    blocked_multiply_add(
+      width, width, width,
+      left.data(), left.get_stride(),
+      right.data(), right.get_stride(),
+      out.data(), out.get_stride()
+    );
+    return;
+  }
+
+  const size_t half = width / 2;
+
+  const in_view A11(left.quadrant(0));
+  const in_view A12(left.quadrant(1));
+  const in_view A21(left.quadrant(2));
+  const in_view A22(left.quadrant(3));
+
+  const in_view B11(right.quadrant(0));
+  const in_view B12(right.quadrant(1));
+  const in_view B21(right.quadrant(2));
+  const in_view B22(right.quadrant(3));
+
+  const out_view C11(out.quadrant(0));
+  const out_view C12(out.quadrant(1));
+  const out_view C21(out.quadrant(2));
+  const out_view C22(out.quadrant(3));
+
+  // the temporaries of this level, the rest is for the levels below
+  const out_view X(workspace, half, half);
+  const out_view Y(workspace + half * half, half, half);
+  value_type * next = workspace + 2 * half * half;
+
+  // S3 = A11 - A21, T3 = B22 - B12, P7 = S3 * T3
+  subtract<value_type>(A11, A21, X);
+  subtract<value_type>(B22, B12, Y);
+  winograd_recurse<value_type>(X, Y, C21, next, crossover_width);
+
+  // S1 = A21 + A22, T1 = B12 - B11, P5 = S1 * T1
+  add<value_type>(A21, A22, X);
+  subtract<value_type>(B12, B11, Y);
+  winograd_recurse<value_type>(X, Y, C22, next, crossover_width);
+
+  // S2 = S1 - A11, T2 = B22 - T1, P6 = S2 * T2
+  subtract_from<value_type>(A11, X);
+  subtract<value_type>(B22, Y, Y);
+  winograd_recurse<value_type>(X, Y, C12, next, crossover_width);
+
+  // S4 = A12 - S2, P3 = S4 * B22
+  subtract<value_type>(A12, X, X);
+  winograd_recurse<value_type>(X, B22, C11, next, crossover_width);
+
+  // P1 = A11 * B11
+  winograd_recurse<value_type>(A11, B11, X, next, crossover_width);
+
+  // U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5, U7 = U3 + P5, U5 = U4 + P3
+  add_to<value_type>(X, C12);
+  add_to<value_type>(C12, C21);
+  add_to<value_type>(C22, C12);
+  add_to<value_type>(C21, C22);
+  add_to<value_type>(C11, C12);
+
+  // T4 = T2 - B21, P4 = A22 * T4, U6 = U3 - P4
+  subtract_from<value_type>(B21, Y);
+  winograd_recurse<value_type>(A22, Y, C11, next, crossover_width);
+  subtract_from<value_type>(C11, C21);
+
+  // P2 = A12 * B21, U1 = P1 + P2
+  winograd_recurse<value_type>(A12, B21, C11, next, crossover_width);
+  add_to<value_type>(X, C11);
+}
+
+}
+
+// workspace is resized as needed and may be reused by subsequent calls
+template<typename square_matrix>
+square_matrix winograd_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  std::vector<typename square_matrix::container::value_type>& workspace,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
+)
+{
+  typedef typename square_matrix::container::value_type value_type;
+
+  if( left.get_width() != right.get_width() )
+  {
+    throw std::out_of_range("matrix width differs, "
+      "winograd matrix multiply impossible");
+  }
+
+  typedef mm::matrix_view<const value_type> in_view;
+  typedef mm::matrix_view<value_type> out_view;
+
+  const size_t width = left.get_width();
+  const size_t padded_width = mm::strassen_padded_width(width, crossover_width);
+
+  const size_t workspace_size =
+    mm::winograd_multiply_workspace_size(width, crossover_width);
+  if( workspace.size() < workspace_size )
+    workspace.resize(workspace_size);
+
+  square_matrix result(width);
+
+  if( padded_width == width )
+  {
+    mm::winograd_recurse<value_type>(
+      in_view(left.raw_data(), width, width),
+      in_view(right.raw_data(), width, width),
+      out_view(result.raw_data(), width, width),
+      workspace.data(),
+      crossover_width
+    );
+    return result;
+  }
+
+  // the padded operands and product come first, the recursion's
+  // temporaries after them; a reused workspace holds stale values, so the
+  // padded operands are cleared before the operands are copied in
+  const size_t padded_size = padded_width * padded_width;
+  value_type * padded_left = workspace.data();
+  value_type * padded_right = padded_left + padded_size;
+  value_type * padded_out = padded_right + padded_size;
+  std::fill(padded_left, padded_out, value_type());
+
+  mm::copy<value_type>(
+    in_view(left.raw_data(), width, width),
+    out_view(padded_left, width, padded_width)
+  );
+  mm::copy<value_type>(
+    in_view(right.raw_data(), width, width),
+    out_view(padded_right, width, padded_width)
+  );
+
+  mm::winograd_recurse<value_type>(
+    in_view(padded_left, padded_width, padded_width),
+    in_view(padded_right, padded_width, padded_width),
+    out_view(padded_out, padded_width, padded_width),
+    padded_out + padded_size,
+    crossover_width
+  );
+
+  mm::copy<value_type>(
+    in_view(padded_out, width, padded_width),
+    out_view(result.raw_data(), width, width)
+  );
+
+  return result;
+}
+
+template<typename square_matrix>
+square_matrix winograd_matrix_multiply(
+  const square_matrix& left,
+  const square_matrix& right,
+  size_t crossover_width =
+    strassen_crossover<typename square_matrix::container::value_type>::value
+)
+{
+  std::vector<typename square_matrix::container::value_type> workspace;
+  return winograd_matrix_multiply(left, right, workspace, crossover_width);
+}
+
+}
+
+#endif // AL_WINOGRAD_MATRIX_MULTIPLY_H
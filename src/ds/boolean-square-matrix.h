@@ -0,0 +1,216 @@
+#ifndef DS_BOOLEAN_SQUARE_MATRIX_H
+#define DS_BOOLEAN_SQUARE_MATRIX_H
+
+/*
+ * square_matrix<bool>: a Boolean matrix with bit-packed rows, 64 elements
+ * per word, multiplied over the Boolean semiring (or, and), e.g. for graph
+ * reachability: (A * B)(i, j) is true iff A(i, k) and B(k, j) for any k.
+ *
+ * The product uses the method of Four Russians: the rows of B are taken in
+ * groups of 8, and all 256 disjunctions of the rows of a group are
+ * tabulated once. Every row of the product then needs one table lookup
+ * (a whole row, or-ed in word by word) per group instead of up to 8, which
+ * makes the product O(n^3 / (64 * 8)) word operations.
+ *
+ * Bits of the last word of a row beyond the width are always zero.
+ *
+ * References:
+ * - Arlazarov, Dinic, Kronrod, Faradzev: On economical construction of the
+ *   transitive closure of a directed graph
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "util/aligned-allocator.h"
+
+namespace ds {
+
+template<typename value_type>
+class square_matrix;
+
+template<>
+class square_matrix<bool>
+{
+  public:
+    typedef uint64_t word;
+    typedef std::vector<word, util::aligned_allocator<word>> container;
+
+    static const size_t word_bits = 64;
+
+    explicit square_matrix(size_t matrix_width)
+    : width(matrix_width),
+      words_per_row((matrix_width + word_bits - 1) / word_bits),
+      words()
+    {
+      if( matrix_width < 1 )
+        throw std::out_of_range("width must be at least 1");
+
+      this->words.resize(this->width * this->words_per_row, 0);
+    }
+
+    bool get(size_t row, size_t col) const
+    {
+      this->check_index(row, col);
+      return (this->row(row)[col / word_bits] >> (col % word_bits)) & 1;
+    }
+
+    void set(size_t row, size_t col, bool val)
+    {
+      this->check_index(row, col);
+
+      const word mask = word(1) << (col % word_bits);
+      if( val )
+        this->row(row)[col / word_bits] |= mask;
+      else
+        this->row(row)[col / word_bits] &= ~mask;
+    }
+
+    // the Boolean product (or of ands)
+    square_matrix operator*(const square_matrix& other) const
+    {
+      if( this->width != other.width )
+        throw std::out_of_range("matrix width differs, "
+          "multiplication impossible");
+
+      const size_t group_bits = 8;
+      const size_t row_words = this->words_per_row;
+
+      square_matrix result(this->width);
+      std::vector<word> table((size_t(1) << group_bits) * row_words);
+
+      for(size_t group = 0; group < this->width; group += group_bits)
+      {
+        const size_t bits = std::min(group_bits, this->width - group);
+        const size_t combinations = size_t(1) << bits;
+
+        // table[m] = table[m without its lowest bit] | row of that bit
+        std::fill(table.begin(), table.begin() + row_words, 0);
+        for(size_t m = 1; m < combinations; ++m)
+        {
+          size_t lowest = 0;
+          while( !((m >> lowest) & 1) )
+            ++lowest;
+
+          const word * previous = &table[(m & (m - 1)) * row_words];
+          const word * b_row = other.row(group + lowest);
+          word * entry = &table[m * row_words];
+          for(size_t w = 0; w < row_words; ++w)
+            entry[w] = previous[w] | b_row[w];
+        }
+
+        // groups never straddle words, 8 divides 64
+        for(size_t i = 0; i < this->width; ++i)
+        {
+          const size_t m = static_cast<size_t>(
+            (this->row(i)[group / word_bits] >> (group % word_bits)) &
+            (combinations - 1)
+          );
+          if( m == 0 )
+            continue;
+
+          const word * entry = &table[m * row_words];
+          word * out = result.row(i);
+          for(size_t w = 0; w < row_words; ++w)
+            out[w] |= entry[w];
+        }
+      }
+
+      return result;
+    }
+
+    // element wise or
+    square_matrix operator|(const square_matrix& other) const
+    {
+      if( this->width != other.width )
+        throw std::out_of_range("matrix width differs, "
+          "disjunction impossible");
+
+      square_matrix result(*this);
+      for(size_t i = 0; i < result.words.size(); ++i)
+        result.words[i] |= other.words[i];
+
+      return result;
+    }
+
+    bool operator==(const square_matrix& other) const
+    {
+      return this->width == other.width && this->words == other.words;
+    }
+
+    bool operator!=(const square_matrix& other) const
+    {
+      return !this->operator==(other);
+    }
+
+    // number of true elements
+    size_t count() const
+    {
+      size_t result = 0;
+      for(auto w : this->words)
+      {
+#if defined(__GNUC__)
+        result += static_cast<size_t>(__builtin_popcountll(w));
+#else
+        for(; w; w &= w - 1)
+          ++result;
+#endif
+      }
+
+      return result;
+    }
+
+    void print(std::ostream& out = std::cout) const
+    {
+      for(size_t r = 0; r < this->width; ++r)
+      {
+        out << "\n";
+        for(size_t c = 0; c < this->width; ++c)
+          out << this->get(r, c) << "\t";
+      }
+
+      out << "\n";
+    }
+
+    size_t get_width() const
+    {
+      return this->width;
+    }
+
+    size_t get_words_per_row() const
+    {
+      return this->words_per_row;
+    }
+
+    // the words_per_row words of a row, bit c % 64 of word c / 64 is
+    // column c; unchecked
+    const word * row(size_t index) const
+    {
+      return this->words.data() + index * this->words_per_row;
+    }
+
+    word * row(size_t index)
+    {
+      return this->words.data() + index * this->words_per_row;
+    }
+
+  private:
+    void check_index(size_t row, size_t col) const
+    {
+      if( row >= this->width || col >= this->width )
+        throw std::out_of_range("matrix index out of bounds");
+    }
+
+    size_t width;
+    size_t words_per_row;
+    container words;
+};
+
+}
+
+#endif // DS_BOOLEAN_SQUARE_MATRIX_H
@@ -0,0 +1,400 @@
+#ifndef DS_MATRIX_H
+#define DS_MATRIX_H
+
+/*
+ * A dense rows x cols matrix.
+ *
+ * Elements are stored either row-major (element (r, c) at
+ * r * leading_dimension + c) or column-major (at c * leading_dimension + r).
+ * The leading dimension defaults to the tight value (cols for row-major,
+ * rows for column-major) and may be larger, e.g. to align rows. The buffer
+ * itself is cache line aligned.
+ *
+ * ds::matrix_view is a non-owning window into a matrix (or any buffer),
+ * described by a row stride and a column stride, so views of transposed or
+ * column-major data and submatrices need no copies.
+ *
+ * Multiplication uses the classical blocked kernel of al/mm/blocked-kernel.h
+ * for any combination of layouts, multiplication with a vector the kernel of
+ * al/mm/gemv-kernel.h.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "al/mm/blocked-kernel.h"
+#include "al/mm/gemv-kernel.h"
+#include "util/aligned-allocator.h"
+
+namespace ds {
+
+enum class matrix_layout
+{
+  row_major,
+  column_major
+};
+
+template<typename value_type>
+class matrix_view
+{
+  public:
+    matrix_view(
+      value_type * data,
+      size_t num_rows,
+      size_t num_cols,
+      size_t row_stride,
+      size_t col_stride
+    )
+    : begin(data),
+      rows(num_rows),
+      cols(num_cols),
+      r_stride(row_stride),
+      c_stride(col_stride)
+    {
+    }
+
+    // implicit conversion from a mutable to a const view
+    template<
+      typename other_type,
+      typename = typename std::enable_if<
+        std::is_convertible<other_type *, value_type *>::value
+      >::type
+    >
+    matrix_view(const matrix_view<other_type>& other)
+    : begin(other.data()),
+      rows(other.get_rows()),
+      cols(other.get_cols()),
+      r_stride(other.row_stride()),
+      c_stride(other.col_stride())
+    {
+    }
+
+    value_type get(size_t row, size_t col) const
+    {
+      return *this->at(row, col);
+    }
+
+    void set(size_t row, size_t col, value_type val) const
+    {
+      *this->at(row, col) = val;
+    }
+
+    // the num_rows x num_cols window starting at (row, col)
+    matrix_view view(
+      size_t row,
+      size_t col,
+      size_t num_rows,
+      size_t num_cols
+    ) const
+    {
+      if( row + num_rows > this->rows || col + num_cols > this->cols )
+        throw std::out_of_range("view exceeds matrix bounds");
+
+      return matrix_view(
+        this->begin + row * this->r_stride + col * this->c_stride,
+        num_rows,
+        num_cols,
+        this->r_stride,
+        this->c_stride
+      );
+    }
+
+    // the transposed matrix, without copying
+    matrix_view transposed() const
+    {
+      return matrix_view(
+        this->begin, this->cols, this->rows, this->c_stride, this->r_stride
+      );
+    }
+
+    value_type * data() const
+    {
+      return this->begin;
+    }
+
+    size_t get_rows() const
+    {
+      return this->rows;
+    }
+
+    size_t get_cols() const
+    {
+      return this->cols;
+    }
+
+    size_t row_stride() const
+    {
+      return this->r_stride;
+    }
+
+    size_t col_stride() const
+    {
+      return this->c_stride;
+    }
+
+  private:
+    value_type * at(size_t row, size_t col) const
+    {
+      if( row >= this->rows || col >= this->cols )
+        throw std::out_of_range("matrix index out of bounds");
+
+      return this->begin + row * this->r_stride + col * this->c_stride;
+    }
+
+    value_type * begin;
+    size_t rows;
+    size_t cols;
+    size_t r_stride;
+    size_t c_stride;
+};
+
+// out += left * right
+template<typename value_type>
+void multiply_add(
+  matrix_view<const value_type> left,
+  matrix_view<const value_type> right,
+  matrix_view<value_type> out
+)
+{
+  if( left.get_cols() != right.get_rows() )
+    throw std::out_of_range("inner matrix dimensions differ, "
+      "multiplication impossible");
+
+  if( out.get_rows() != left.get_rows() || out.get_cols() != right.get_cols() )
+    throw std::out_of_range("result matrix has the wrong dimensions");
+
+  al::mm::blocked_multiply_add(
+    out.get_rows(), out.get_cols(), left.get_cols(),
+    left.data(), left.row_stride(), left.col_stride(),
+    right.data(), right.row_stride(), right.col_stride(),
+    out.data(), out.row_stride(), out.col_stride()
+  );
+}
+
+template<typename value_type = int>
+class matrix
+{
+  public:
+    // cache line aligned, for the vectorized kernels
+    typedef std::vector<value_type, util::aligned_allocator<value_type>>
+      container;
+
+    matrix(
+      size_t num_rows,
+      size_t num_cols,
+      matrix_layout storage_layout = matrix_layout::row_major,
+      // 0: tight, cols for row-major, rows for column-major
+      size_t leading_dimension = 0
+    )
+    : rows(num_rows),
+      cols(num_cols),
+      layout(storage_layout),
+      ld(tight_or(leading_dimension, num_rows, num_cols, storage_layout)),
+      data()
+    {
+      if( num_rows < 1 || num_cols < 1 )
+        throw std::out_of_range("rows and cols must be at least 1");
+
+      const size_t tight_ld = tight_or(0, num_rows, num_cols, storage_layout);
+      if( this->ld < tight_ld )
+        throw std::out_of_range("leading dimension too small");
+
+      // rows of a row-major matrix, columns of a column-major matrix
+      const size_t num_lines = this->is_row_major() ? num_rows : num_cols;
+      this->data.resize(num_lines * this->ld, value_type());
+    }
+
+    value_type get(size_t row, size_t col) const
+    {
+      return this->view().get(row, col);
+    }
+
+    void set(size_t row, size_t col, value_type val)
+    {
+      this->view().set(row, col, val);
+    }
+
+    matrix_view<value_type> view()
+    {
+      return matrix_view<value_type>(
+        this->data.data(),
+        this->rows,
+        this->cols,
+        this->row_stride(),
+        this->col_stride()
+      );
+    }
+
+    matrix_view<const value_type> view() const
+    {
+      return matrix_view<const value_type>(
+        this->data.data(),
+        this->rows,
+        this->cols,
+        this->row_stride(),
+        this->col_stride()
+      );
+    }
+
+    matrix_view<value_type> view(
+      size_t row,
+      size_t col,
+      size_t num_rows,
+      size_t num_cols
+    )
+    {
+      return this->view().view(row, col, num_rows, num_cols);
+    }
+
+    matrix_view<const value_type> view(
+      size_t row,
+      size_t col,
+      size_t num_rows,
+      size_t num_cols
+    ) const
+    {
+      return this->view().view(row, col, num_rows, num_cols);
+    }
+
+    // the result has the layout of this matrix
+    matrix operator*(const matrix& other) const
+    {
+      if( this->cols != other.rows )
+        throw std::out_of_range("inner matrix dimensions differ, "
+          "multiplication impossible");
+
+      matrix result(this->rows, other.cols, this->layout);
+      multiply_add<value_type>(this->view(), other.view(), result.view());
+
+      return result;
+    }
+
+    // the matrix-vector product
+    std::vector<value_type> operator*(const std::vector<value_type>& x) const
+    {
+      if( x.size() != this->cols )
+        throw std::out_of_range("vector size differs from matrix cols, "
+          "multiplication impossible");
+
+      std::vector<value_type> y(this->rows, value_type());
+      al::mm::gemv_multiply_add(
+        this->rows, this->cols,
+        this->data.data(), this->row_stride(), this->col_stride(),
+        x.data(), y.data()
+      );
+
+      return y;
+    }
+
+    // compares elements, regardless of layout and leading dimension
+    bool operator==(const matrix& other) const
+    {
+      if( this->rows != other.rows || this->cols != other.cols )
+        return false;
+
+      for(size_t r = 0; r < this->rows; ++r)
+        for(size_t c = 0; c < this->cols; ++c)
+          if( !(this->element(r, c) == other.element(r, c)) )
+            return false;
+
+      return true;
+    }
+
+    bool operator!=(const matrix& other) const
+    {
+      return !this->operator==(other);
+    }
+
+    void print(std::ostream& out = std::cout) const
+    {
+      for(size_t r = 0; r < this->rows; ++r)
+      {
+        out << "\n";
+        for(size_t c = 0; c < this->cols; ++c)
+          out << this->element(r, c) << "\t";
+      }
+
+      out << "\n";
+    }
+
+    size_t get_rows() const
+    {
+      return this->rows;
+    }
+
+    size_t get_cols() const
+    {
+      return this->cols;
+    }
+
+    matrix_layout get_layout() const
+    {
+      return this->layout;
+    }
+
+    size_t get_leading_dimension() const
+    {
+      return this->ld;
+    }
+
+    size_t row_stride() const
+    {
+      return this->is_row_major() ? this->ld : 1;
+    }
+
+    size_t col_stride() const
+    {
+      return this->is_row_major() ? 1 : this->ld;
+    }
+
+    // the underlying buffer, including the padding of the leading dimension
+    const value_type * raw_data() const
+    {
+      return this->data.data();
+    }
+
+    value_type * raw_data()
+    {
+      return this->data.data();
+    }
+
+  private:
+    static size_t tight_or(
+      size_t leading_dimension,
+      size_t num_rows,
+      size_t num_cols,
+      matrix_layout storage_layout
+    )
+    {
+      if( leading_dimension )
+        return leading_dimension;
+
+      return storage_layout == matrix_layout::row_major ? num_cols : num_rows;
+    }
+
+    bool is_row_major() const
+    {
+      return this->layout == matrix_layout::row_major;
+    }
+
+    // unchecked
+    const value_type& element(size_t row, size_t col) const
+    {
+      return this->data[row * this->row_stride() + col * this->col_stride()];
+    }
+
+    size_t rows;
+    size_t cols;
+    matrix_layout layout;
+    size_t ld;
+    container data;
+};
+
+}
+
+#endif // DS_MATRIX_H
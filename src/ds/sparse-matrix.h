@@ -0,0 +1,561 @@
+#ifndef DS_SPARSE_MATRIX_H
+#define DS_SPARSE_MATRIX_H
+
+/*
+ * A sparse rows x cols matrix storing only its non-zero elements.
+ *
+ * matrix_layout::row_major stores it in compressed sparse row format (CSR):
+ * the column indices and values of all non-zeros, row after row, and for
+ * every row the offset of its first non-zero. matrix_layout::column_major
+ * is the compressed sparse column format (CSC), the same with rows and
+ * columns swapped. Below, a "line" is a row (CSR) or a column (CSC).
+ *
+ * Indices within a line are sorted, so get() is a binary search.
+ *
+ * Multiplying two sparse matrices uses Gustavson's algorithm, which builds
+ * every line of the result from the lines of the right operand selected
+ * by the non-zeros of the left operand's line. The result has the layout
+ * of the left operand.
+ *
+ * See al/parallel-sparse-matrix-multiply.h for multi-threaded versions of
+ * operator*.
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ds/matrix.h"
+#include "ds/square-matrix.h"
+
+namespace ds {
+
+template<typename value_type>
+struct sparse_entry
+{
+  size_t row;
+  size_t col;
+  value_type value;
+};
+
+template<typename value_type>
+class sparse_matrix;
+
+}
+
+namespace util {
+
+class thread_pool;
+
+}
+
+namespace al {
+
+template<typename value_type>
+ds::sparse_matrix<value_type> parallel_sparse_matrix_multiply(
+  const ds::sparse_matrix<value_type>& left,
+  const ds::sparse_matrix<value_type>& right,
+  util::thread_pool& pool
+);
+
+}
+
+namespace ds {
+
+namespace detail {
+
+// the lines [first, last) of a sparse product
+template<typename value_type>
+struct sparse_lines
+{
+  sparse_lines() : counts(), indices(), values() {}
+
+  std::vector<size_t> counts;
+  std::vector<size_t> indices;
+  std::vector<value_type> values;
+};
+
+// y = matrix * x, restricted to the lines [first, last):
+// CSR assigns y[first..last), CSC adds the contributions of the columns
+// [first, last) to all of y
+template<typename value_type>
+void sparse_multiply_lines(
+  const sparse_matrix<value_type>& matrix,
+  size_t first,
+  size_t last,
+  const value_type * x,
+  value_type * y
+)
+{
+  const std::vector<size_t>& offsets = matrix.get_offsets();
+  const std::vector<size_t>& indices = matrix.get_indices();
+  const std::vector<value_type>& values = matrix.get_values();
+
+  if( matrix.get_layout() == matrix_layout::row_major )
+  {
+    for(size_t row = first; row < last; ++row)
+    {
+      value_type sum = value_type();
+      for(size_t i = offsets[row]; i < offsets[row + 1]; ++i)
+        sum += values[i] * x[indices[i]];
+
+      y[row] = sum;
+    }
+  }
+  else
+  {
+    for(size_t col = first; col < last; ++col)
+      for(size_t i = offsets[col]; i < offsets[col + 1]; ++i)
+        y[indices[i]] += values[i] * x[col];
+  }
+}
+
+// Gustavson's algorithm for the lines [first, last) of left * right, both
+// in the same layout. For CSC, this computes the lines of
+// (right^T * left^T)^T, which is the same thing.
+template<typename value_type>
+sparse_lines<value_type> sparse_multiply_lines(
+  const sparse_matrix<value_type>& left,
+  const sparse_matrix<value_type>& right,
+  size_t first,
+  size_t last
+)
+{
+  const bool csr = left.get_layout() == matrix_layout::row_major;
+  const sparse_matrix<value_type>& outer = csr ? left : right;
+  const sparse_matrix<value_type>& inner = csr ? right : left;
+  const size_t line_length = csr ? right.get_cols() : left.get_rows();
+
+  const std::vector<size_t>& outer_offsets = outer.get_offsets();
+  const std::vector<size_t>& outer_indices = outer.get_indices();
+  const std::vector<value_type>& outer_values = outer.get_values();
+  const std::vector<size_t>& inner_offsets = inner.get_offsets();
+  const std::vector<size_t>& inner_indices = inner.get_indices();
+  const std::vector<value_type>& inner_values = inner.get_values();
+
+  sparse_lines<value_type> result;
+  result.counts.reserve(last - first);
+
+  // dense accumulator for one line, and which of its elements are in use
+  std::vector<value_type> accumulator(line_length, value_type());
+  std::vector<bool> used(line_length, false);
+  std::vector<size_t> used_indices;
+
+  for(size_t line = first; line < last; ++line)
+  {
+    for(size_t i = outer_offsets[line]; i < outer_offsets[line + 1]; ++i)
+    {
+      const size_t k = outer_indices[i];
+      const value_type factor = outer_values[i];
+
+      for(size_t j = inner_offsets[k]; j < inner_offsets[k + 1]; ++j)
+      {
+        const size_t index = inner_indices[j];
+        if( !used[index] )
+        {
+          used[index] = true;
+          used_indices.push_back(index);
+        }
+        accumulator[index] += factor * inner_values[j];
+      }
+    }
+
+    std::sort(used_indices.begin(), used_indices.end());
+
+    size_t count = 0;
+    for(auto index : used_indices)
+    {
+      // drop elements that cancelled out
+      if( !(accumulator[index] == value_type()) )
+      {
+        result.indices.push_back(index);
+        result.values.push_back(accumulator[index]);
+        ++count;
+      }
+
+      accumulator[index] = value_type();
+      used[index] = false;
+    }
+
+    result.counts.push_back(count);
+    used_indices.clear();
+  }
+
+  return result;
+}
+
+}
+
+template<typename value_type = int>
+class sparse_matrix
+{
+  public:
+    typedef sparse_entry<value_type> entry;
+
+    // all zero
+    sparse_matrix(
+      size_t num_rows,
+      size_t num_cols,
+      matrix_layout storage_layout = matrix_layout::row_major
+    )
+    : rows(num_rows),
+      cols(num_cols),
+      layout(storage_layout),
+      offsets(),
+      indices(),
+      values()
+    {
+      if( num_rows < 1 || num_cols < 1 )
+        throw std::out_of_range("rows and cols must be at least 1");
+
+      this->offsets.assign(this->num_lines() + 1, 0);
+    }
+
+    // from (row, col, value) entries in any order, the values of entries
+    // with the same row and col are summed up
+    sparse_matrix(
+      size_t num_rows,
+      size_t num_cols,
+      std::vector<entry> entries,
+      matrix_layout storage_layout = matrix_layout::row_major
+    )
+    : sparse_matrix(num_rows, num_cols, storage_layout)
+    {
+      for(const auto& e : entries)
+        if( e.row >= this->rows || e.col >= this->cols )
+          throw std::out_of_range("sparse matrix entry out of bounds");
+
+      std::sort(entries.begin(), entries.end(),
+        [this](const entry& l, const entry& r) {
+          return this->line_of(l) < this->line_of(r) ||
+            (this->line_of(l) == this->line_of(r) &&
+             this->index_of(l) < this->index_of(r));
+        }
+      );
+
+      for(size_t i = 0; i < entries.size(); )
+      {
+        const size_t line = this->line_of(entries[i]);
+        const size_t index = this->index_of(entries[i]);
+
+        value_type sum = value_type();
+        for(; i < entries.size() && this->line_of(entries[i]) == line &&
+              this->index_of(entries[i]) == index; ++i)
+          sum += entries[i].value;
+
+        if( !(sum == value_type()) )
+        {
+          this->indices.push_back(index);
+          this->values.push_back(sum);
+          ++this->offsets[line + 1];
+        }
+      }
+
+      this->accumulate_offsets();
+    }
+
+    explicit sparse_matrix(
+      const matrix<value_type>& dense,
+      matrix_layout storage_layout = matrix_layout::row_major
+    )
+    : sparse_matrix(dense.get_rows(), dense.get_cols(), storage_layout)
+    {
+      for(size_t line = 0; line < this->num_lines(); ++line)
+      {
+        for(size_t index = 0; index < this->line_length(); ++index)
+        {
+          const value_type val = this->is_row_major()
+            ? dense.get(line, index)
+            : dense.get(index, line);
+
+          if( !(val == value_type()) )
+          {
+            this->indices.push_back(index);
+            this->values.push_back(val);
+          }
+        }
+
+        this->offsets[line + 1] = this->indices.size();
+      }
+    }
+
+    explicit sparse_matrix(
+      const square_matrix<value_type>& dense,
+      matrix_layout storage_layout = matrix_layout::row_major
+    )
+    : sparse_matrix(dense.as_matrix(), storage_layout)
+    {
+    }
+
+    matrix<value_type> to_matrix() const
+    {
+      matrix<value_type> dense(this->rows, this->cols);
+      for(size_t line = 0; line < this->num_lines(); ++line)
+      {
+        for(size_t i = this->offsets[line]; i < this->offsets[line + 1]; ++i)
+        {
+          if( this->is_row_major() )
+            dense.set(line, this->indices[i], this->values[i]);
+          else
+            dense.set(this->indices[i], line, this->values[i]);
+        }
+      }
+
+      return dense;
+    }
+
+    square_matrix<value_type> to_square_matrix() const
+    {
+      if( this->rows != this->cols )
+        throw std::out_of_range("matrix is not square, "
+          "conversion to square matrix impossible");
+
+      const matrix<value_type> dense = this->to_matrix();
+      square_matrix<value_type> square(this->rows);
+      std::copy(
+        dense.raw_data(),
+        dense.raw_data() + this->rows * this->cols,
+        square.raw_data()
+      );
+
+      return square;
+    }
+
+    // the same matrix in CSR (row_major) or CSC (column_major) format
+    sparse_matrix with_layout(matrix_layout storage_layout) const
+    {
+      if( storage_layout == this->layout )
+        return *this;
+
+      // a counting sort of all non-zeros by index, which becomes the line
+      sparse_matrix result(this->rows, this->cols, storage_layout);
+      for(auto index : this->indices)
+        ++result.offsets[index + 1];
+      result.accumulate_offsets();
+
+      result.indices.resize(this->indices.size());
+      result.values.resize(this->values.size());
+
+      std::vector<size_t> next(
+        result.offsets.begin(), result.offsets.end() - 1
+      );
+      for(size_t line = 0; line < this->num_lines(); ++line)
+      {
+        for(size_t i = this->offsets[line]; i < this->offsets[line + 1]; ++i)
+        {
+          const size_t target = next[this->indices[i]]++;
+          result.indices[target] = line;
+          result.values[target] = this->values[i];
+        }
+      }
+
+      return result;
+    }
+
+    value_type get(size_t row, size_t col) const
+    {
+      if( row >= this->rows || col >= this->cols )
+        throw std::out_of_range("matrix index out of bounds");
+
+      const size_t line = this->is_row_major() ? row : col;
+      const size_t index = this->is_row_major() ? col : row;
+
+      const auto begin = this->indices.begin() + this->offsets[line];
+      const auto end = this->indices.begin() + this->offsets[line + 1];
+      const auto found = std::lower_bound(begin, end, index);
+
+      if( found == end || *found != index )
+        return value_type();
+
+      return this->values[static_cast<size_t>(found - this->indices.begin())];
+    }
+
+    std::vector<value_type> operator*(const std::vector<value_type>& x) const
+    {
+      if( x.size() != this->cols )
+        throw std::out_of_range("vector size differs from matrix cols, "
+          "multiplication impossible");
+
+      std::vector<value_type> y(this->rows, value_type());
+      detail::sparse_multiply_lines(
+        *this, 0, this->num_lines(), x.data(), y.data()
+      );
+
+      return y;
+    }
+
+    // the result has the layout of this matrix
+    sparse_matrix operator*(const sparse_matrix& other) const
+    {
+      if( this->cols != other.rows )
+        throw std::out_of_range("inner matrix dimensions differ, "
+          "multiplication impossible");
+
+      if( other.layout != this->layout )
+        return this->operator*(other.with_layout(this->layout));
+
+      sparse_matrix result(this->rows, other.cols, this->layout);
+      result.assign_lines(
+        std::vector<detail::sparse_lines<value_type>>(1,
+          detail::sparse_multiply_lines(*this, other, 0, result.num_lines())
+        )
+      );
+
+      return result;
+    }
+
+    bool operator==(const sparse_matrix& other) const
+    {
+      if( other.layout != this->layout )
+        return this->operator==(other.with_layout(this->layout));
+
+      return this->rows == other.rows && this->cols == other.cols &&
+        this->offsets == other.offsets &&
+        this->indices == other.indices &&
+        this->values == other.values;
+    }
+
+    bool operator!=(const sparse_matrix& other) const
+    {
+      return !this->operator==(other);
+    }
+
+    void print(std::ostream& out = std::cout) const
+    {
+      this->to_matrix().print(out);
+    }
+
+    size_t get_rows() const
+    {
+      return this->rows;
+    }
+
+    size_t get_cols() const
+    {
+      return this->cols;
+    }
+
+    matrix_layout get_layout() const
+    {
+      return this->layout;
+    }
+
+    size_t nonzeros() const
+    {
+      return this->values.size();
+    }
+
+    // number of rows (CSR) or columns (CSC)
+    size_t num_lines() const
+    {
+      return this->is_row_major() ? this->rows : this->cols;
+    }
+
+    // for every line the offset of its first non-zero, plus nonzeros()
+    const std::vector<size_t>& get_offsets() const
+    {
+      return this->offsets;
+    }
+
+    // the column (CSR) or row (CSC) of every non-zero
+    const std::vector<size_t>& get_indices() const
+    {
+      return this->indices;
+    }
+
+    const std::vector<value_type>& get_values() const
+    {
+      return this->values;
+    }
+
+  private:
+    // assembles the product from parts computed by tasks
+    friend sparse_matrix al::parallel_sparse_matrix_multiply<value_type>(
+      const sparse_matrix& left,
+      const sparse_matrix& right,
+      util::thread_pool& pool
+    );
+
+    // replaces all lines by the concatenation of parts, which must cover
+    // num_lines() lines; used to assemble products computed in parts
+    void assign_lines(
+      const std::vector<detail::sparse_lines<value_type>>& parts
+    )
+    {
+      size_t num_lines = 0;
+      size_t num_nonzeros = 0;
+      for(const auto& part : parts)
+      {
+        num_lines += part.counts.size();
+        num_nonzeros += part.values.size();
+      }
+
+      if( num_lines != this->num_lines() )
+        throw std::out_of_range("number of lines differs, "
+          "assignment impossible");
+
+      this->indices.clear();
+      this->values.clear();
+      this->indices.reserve(num_nonzeros);
+      this->values.reserve(num_nonzeros);
+
+      size_t line = 0;
+      for(const auto& part : parts)
+      {
+        this->indices.insert(
+          this->indices.end(), part.indices.begin(), part.indices.end()
+        );
+        this->values.insert(
+          this->values.end(), part.values.begin(), part.values.end()
+        );
+
+        for(auto count : part.counts)
+        {
+          this->offsets[line + 1] = this->offsets[line] + count;
+          ++line;
+        }
+      }
+    }
+
+    bool is_row_major() const
+    {
+      return this->layout == matrix_layout::row_major;
+    }
+
+    size_t line_length() const
+    {
+      return this->is_row_major() ? this->cols : this->rows;
+    }
+
+    size_t line_of(const entry& e) const
+    {
+      return this->is_row_major() ? e.row : e.col;
+    }
+
+    size_t index_of(const entry& e) const
+    {
+      return this->is_row_major() ? e.col : e.row;
+    }
+
+    // per line counts in offsets[1..] to offsets
+    void accumulate_offsets()
+    {
+      for(size_t i = 1; i < this->offsets.size(); ++i)
+        this->offsets[i] += this->offsets[i - 1];
+    }
+
+    size_t rows;
+    size_t cols;
+    matrix_layout layout;
+    std::vector<size_t> offsets;
+    std::vector<size_t> indices;
+    std::vector<value_type> values;
+};
+
+}
+
+#endif // DS_SPARSE_MATRIX_H
@@ -0,0 +1,224 @@
+#ifndef DS_SQUARE_MATRIX_EXPRESSION_H
+#define DS_SQUARE_MATRIX_EXPRESSION_H
+
+/*
+ * Expression templates for element wise square_matrix arithmetic.
+ *
+ * operator+ and operator- don't compute anything, they return a
+ * lightweight expression object describing the computation. Only when an
+ * expression is converted to a square_matrix is every element evaluated,
+ * in a single pass, into the single allocation of the new matrix:
+ *
+ *   ds::square_matrix<int> r(a + b - c + d);  // one loop, no temporaries
+ *
+ * The common case of a single sum or difference of two matrices is
+ * evaluated with the vectorized kernels of al/mm/elementwise.h.
+ *
+ * A product or comparison with an expression evaluates the expression into
+ * a square_matrix first, so (a + b) * (c - d) and a + b == c work as with
+ * matrices.
+ *
+ * Expressions hold references to the matrices they were built from, so
+ * they must not outlive the full expression; don't store them in an
+ * auto variable.
+ *
+ */
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "al/mm/elementwise.h"
+
+namespace ds {
+
+template<typename value_type>
+class square_matrix;
+
+// CRTP base of square_matrix and all expressions
+template<typename expression>
+class matrix_expression
+{
+  public:
+    const expression& self() const
+    {
+      return static_cast<const expression&>(*this);
+    }
+
+  protected:
+    matrix_expression() {}
+    ~matrix_expression() {}
+};
+
+// matrices are held by reference, nested expressions (which are temporaries
+// of the same full expression) by value
+template<typename expression>
+struct expression_operand
+{
+  typedef const expression type;
+};
+
+template<typename value_type>
+struct expression_operand<square_matrix<value_type>>
+{
+  typedef const square_matrix<value_type>& type;
+};
+
+struct expression_plus
+{
+  template<typename value_type>
+  static value_type apply(const value_type& left, const value_type& right)
+  {
+    return left + right;
+  }
+};
+
+struct expression_minus
+{
+  template<typename value_type>
+  static value_type apply(const value_type& left, const value_type& right)
+  {
+    return left - right;
+  }
+};
+
+template<typename left_type, typename right_type, typename operation>
+class binary_matrix_expression
+: public matrix_expression<
+    binary_matrix_expression<left_type, right_type, operation>
+  >
+{
+  public:
+    typedef typename left_type::element_type element_type;
+
+    binary_matrix_expression(const left_type& l, const right_type& r)
+    : left(l),
+      right(r)
+    {
+    }
+
+    element_type element(size_t index) const
+    {
+      return operation::apply(
+        this->left.element(index),
+        this->right.element(index)
+      );
+    }
+
+    size_t get_width() const
+    {
+      return this->left.get_width();
+    }
+
+    const left_type& get_left() const
+    {
+      return this->left;
+    }
+
+    const right_type& get_right() const
+    {
+      return this->right;
+    }
+
+  private:
+    typename expression_operand<left_type>::type left;
+    typename expression_operand<right_type>::type right;
+};
+
+// writes all size elements of source to target
+template<typename expression, typename value_type>
+void evaluate(const expression& source, value_type * target, size_t size)
+{
+  for(size_t i = 0; i < size; ++i)
+    target[i] = source.element(i);
+}
+
+template<typename value_type>
+void evaluate(
+  const binary_matrix_expression<
+    square_matrix<value_type>, square_matrix<value_type>, expression_plus
+  >& source,
+  value_type * target,
+  size_t size
+)
+{
+  al::mm::elementwise::add(
+    source.get_left().raw_data(), source.get_right().raw_data(), target, size
+  );
+}
+
+template<typename value_type>
+void evaluate(
+  const binary_matrix_expression<
+    square_matrix<value_type>, square_matrix<value_type>, expression_minus
+  >& source,
+  value_type * target,
+  size_t size
+)
+{
+  al::mm::elementwise::subtract(
+    source.get_left().raw_data(), source.get_right().raw_data(), target, size
+  );
+}
+
+template<typename left_type, typename right_type>
+binary_matrix_expression<left_type, right_type, expression_plus>
+operator+(
+  const matrix_expression<left_type>& left,
+  const matrix_expression<right_type>& right
+)
+{
+  if( left.self().get_width() != right.self().get_width() )
+    throw std::out_of_range("matrix width differs, addition impossible");
+
+  return binary_matrix_expression<left_type, right_type, expression_plus>(
+    left.self(), right.self()
+  );
+}
+
+template<typename left_type, typename right_type>
+binary_matrix_expression<left_type, right_type, expression_minus>
+operator-(
+  const matrix_expression<left_type>& left,
+  const matrix_expression<right_type>& right
+)
+{
+  if( left.self().get_width() != right.self().get_width() )
+    throw std::out_of_range("matrix width differs, subtraction impossible");
+
+  return binary_matrix_expression<left_type, right_type, expression_minus>(
+    left.self(), right.self()
+  );
+}
+
+// An expression on the left of *, == or != is evaluated here; one on the
+// right (of these or the members of square_matrix) converts implicitly.
+template<typename left_type, typename right_type, typename operation>
+square_matrix<typename left_type::element_type> operator*(
+  const binary_matrix_expression<left_type, right_type, operation>& left,
+  const square_matrix<typename left_type::element_type>& right
+)
+{
+  return square_matrix<typename left_type::element_type>(left) * right;
+}
+
+template<typename left_type, typename right_type, typename operation>
+bool operator==(
+  const binary_matrix_expression<left_type, right_type, operation>& left,
+  const square_matrix<typename left_type::element_type>& right
+)
+{
+  return square_matrix<typename left_type::element_type>(left) == right;
+}
+
+template<typename left_type, typename right_type, typename operation>
+bool operator!=(
+  const binary_matrix_expression<left_type, right_type, operation>& left,
+  const square_matrix<typename left_type::element_type>& right
+)
+{
+  return !(left == right);
+}
+
+}
+
+#endif // DS_SQUARE_MATRIX_EXPRESSION_H
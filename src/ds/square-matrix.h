@@ -9,97 +9,90 @@
 #include <iterator>
 #include <cmath>
 
+#include "al/mm/elementwise.h"
+#include "al/mm/matrix-view.h"
+#include "al/matrix-multiply-policy.h"
+#include "al/matrix-power.h"
+#include "al/small-matrix-multiply.h"
 #include "al/strassen-matrix-multiply.h"
+#include "ds/matrix.h"
+#include "ds/square-matrix-expression.h"
 
 namespace ds {
 
+// a thin wrapper around a row-major ds::matrix with rows == cols
 template<typename value_type = int>
-class square_matrix 
+class square_matrix : public matrix_expression<square_matrix<value_type>>
 {
   public:
-    typedef std::vector<value_type> container;
+    typedef typename matrix<value_type>::container container;
     typedef std::array<square_matrix, 4> split_result;
+    typedef value_type element_type;
 
     explicit square_matrix(size_t matrix_width)
-      : width(matrix_width),
-        data(matrix_width * matrix_width, 0)
+      : elements(checked_width(matrix_width), matrix_width)
     {
-      if( matrix_width < 1 )
-        throw std::out_of_range("width must be at least 1");
     }
 
     square_matrix(const square_matrix& other)
-      : width(other.width),
-        data(other.data)
+      : elements(other.elements)
     {
     }
 
     square_matrix(square_matrix&& other)
-      : width(std::move(other.width)),
-        data(std::move(other.data))
+      : elements(std::move(other.elements))
     {
     }
 
+    // evaluates an expression like a + b - c in a single pass,
+    // see ds/square-matrix-expression.h
+    template<typename expression>
+    square_matrix(const matrix_expression<expression>& expr)
+      : elements(expr.self().get_width(), expr.self().get_width())
+    {
+      evaluate(
+        expr.self(), this->raw_data(), this->get_width() * this->get_width()
+      );
+    }
+
     square_matrix(
       const square_matrix& top_left, 
       const square_matrix& top_right, 
       const square_matrix& bottom_left, 
       const square_matrix& bottom_right
-    ) : width(top_left.width * 2),
-        data(this->width * this->width, 0)
+    ) : elements(top_left.get_width() * 2, top_left.get_width() * 2)
     {
       if( 
-        top_left.width != top_right.width || 
-        bottom_left.width != bottom_right.width || 
-        top_right.width != bottom_right.width 
+        top_left.get_width() != top_right.get_width() || 
+        bottom_left.get_width() != bottom_right.get_width() || 
+        top_right.get_width() != bottom_right.get_width() 
       )
       {
         throw std::out_of_range("inconsistent matrix size, combination impossible");
       }
 
-      const size_t size = this->width * this->width;
-      const size_t source_width = top_left.width;
+      const size_t width = this->get_width();
+      const size_t source_width = top_left.get_width();
+      const al::mm::matrix_view<value_type> target(
+        this->raw_data(), width, width
+      );
 
-      std::array<const square_matrix *, 4> source = {{
+      // see also square_matrix<value_type>::square_split()
+      const square_matrix * source[] = {
         &top_left,
         &top_right,
         &bottom_left,
         &bottom_right
-      }};
-      
-      for(size_t i = 0; i < size; ++i)
+      };
+
+      for(size_t q = 0; q < 4; ++q)
       {
-        // see also square_matrix<value_type>::square_split()
-        
-        // the first pair of arrays (0 and 1) gets put into this matrix's
-        // top half
-        // the second pair of arrays (2 and 3) gets put into this matrix's
-        // bottom half
-        const bool top = i < size / 2;
-        
-        // the arrays on the left (0 and 2) get put into this matrix's left half
-        // the arrays on the right (1 and 3) get put into this matrix's 
-        // right half
-        const bool odd = (i / source_width) & 1;
-        
-        // choose source_matrix 0 1 2 or 3
-        const size_t source_matrix = 
-          2 * static_cast<unsigned int>(!top) + 
-          1 * static_cast<unsigned int>(odd)
-        ;
-        
-        // index in the chosen source_matrix for this i
-        const size_t index = (
-            // map to row
-            (i / this->width) * source_width 
-            // map to column
-            + (i % source_width) 
-          ) 
-          // map to the 4 input arrays
-          % (size / 4)
-        ;
-        
-        this->data[i] = source[source_matrix]->data[index];
+        al::mm::copy<value_type>(
+          al::mm::matrix_view<const value_type>(
+            source[q]->raw_data(), source_width, source_width
+          ),
+          target.quadrant(q)
+        );
       }
     }
 
@@ -111,71 +104,58 @@ class square_matrix
 
     value_type get(size_t row, size_t col) const
     {
-      const size_t index = row * this->width + col;
-
-      if( index >= data.size() )
-        throw std::out_of_range("matrix index out of bounds");
-
-      return data[index];
+      return this->elements.get(row, col);
     }
 
     void set(size_t row, size_t col, value_type val)
     {
-      const size_t index = row * this->width + col;
+      this->elements.set(row, col, val);
+    }
 
-      if( index >= data.size() )
-        throw std::out_of_range("matrix index out of bounds");
+    square_matrix operator*(const square_matrix& other) const
+    {
+      if( this->get_width() <= al::small_matrix_max_width )
+        return al::small_matrix_multiply(*this, other);
 
-      data[index] = val;
+      return al::strassen_matrix_multiply(*this, other);
     }
 
-    square_matrix operator+(square_matrix other) const
+    // with the algorithm chosen by policy, see al/matrix-multiply-policy.h
+    square_matrix multiply(
+      const square_matrix& other,
+      const al::multiply_policy& policy
+    ) const
     {
-      if( other.width != this->width )
-        throw std::out_of_range(
-          "matrix width differs, addition impossible"
-        );
-      
-      auto this_iter = this->data.begin();
-      for(auto i = other.data.begin(); i != other.data.end(); ++i)
-      {
-        *i += *this_iter;
-        ++this_iter;
-      }
-
-      return other;
+      return al::matrix_multiply(*this, other, policy);
     }
 
-    square_matrix operator-(const square_matrix& right) const
+    // this^exponent by repeated squaring, see al/matrix-power.h
+    square_matrix pow(unsigned long long exponent) const
     {
-      if( right.width != this->width )
-        throw std::out_of_range(
-          "matrix width differs, subtraction impossible"
-        );
-      
-      square_matrix left(*this);
-      
-      auto left_iter = left.data.begin();
-      for(auto right_iter = right.data.begin(); right_iter != right.data.end(); ++right_iter)
-      {
-        *left_iter -= *right_iter;
-        ++left_iter;
-      }
+      return al::matrix_power(*this, exponent);
+    }
 
-      return left;
+    // the matrix-vector product
+    std::vector<value_type> operator*(const std::vector<value_type>& x) const
+    {
+      return this->elements * x;
     }
 
-    square_matrix operator*(const square_matrix& other) const
+    square_matrix& operator*=(value_type factor)
     {
-      return al::strassen_matrix_multiply(*this, other);
+      al::mm::elementwise::scale(
+        this->raw_data(),
+        factor,
+        this->raw_data(),
+        this->get_width() * this->get_width()
+      );
+
+      return *this;
     }
     
     bool operator==(const square_matrix& other) const
     {
-      if( other.width != this->width )
-        return false;
-      
-      return this->data == other.data;
+      return this->elements == other.elements;
     }
     
     bool operator!=(const square_matrix& other) const
@@ -185,84 +165,91 @@ class square_matrix
 
     split_result square_split() const
     {
-      if( this->width < 2 || (this->width & (this->width - 1)) != 0 )
+      const size_t width = this->get_width();
+      if( width < 2 || (width & (width - 1)) != 0 )
         throw std::out_of_range("matrix width < 2 or not a power of two, "
           "square split impossible");
 
-      const size_t size = this->width * this->width;
-      const size_t result_width = this->width >> 1;
+      const size_t result_width = width >> 1;
+      const al::mm::matrix_view<const value_type> source(
+        this->raw_data(), width, width
+      );
 
+      // top left, top right, bottom left, bottom right
       split_result result = {{
         square_matrix<value_type>(result_width),
         square_matrix<value_type>(result_width),
         square_matrix<value_type>(result_width),
         square_matrix<value_type>(result_width)
       }};
-      
-      for(size_t i = 0; i < size; ++i)
+
+      for(size_t q = 0; q < 4; ++q)
       {
-        // the first half gets put into the first pair of arrays (0 and 1)
-        // the second half gets put into the second pair of arrays (2 and 3)
-        const bool top = i < size / 2;
-        
-        // map all odd half-rows to the left pair of arrays (0 and 2)
-        // map all even half-rows to the rigth pair of arrays (1 and 3)
-        const bool odd = (i / result_width) & 1;
-        
-        // choose result_matrix 0 1 2 or 3
-        const size_t result_matrix = 
-          2 * static_cast<unsigned int>(!top) + 
-          1 * static_cast<unsigned int>(odd)
-        ;
-        
-        // index in the chosen result_matrix for this i
-        const size_t index = (
-            // map to row
-            (i / this->width) * result_width 
-            // map to column
-            + (i % result_width) 
-          ) 
-          // map to 4 arrays
-          % (size / 4)
-        ;
-        
-        result[result_matrix].data[index] = this->data[i];
+        al::mm::copy<value_type>(
+          source.quadrant(q),
+          al::mm::matrix_view<value_type>(
+            result[q].raw_data(), result_width, result_width
+          )
+        );
       }
-      
+
       return result;
     }
 
     void print(std::ostream& out = std::cout) const
     {
-      for(size_t i = 0; i < this->data.size(); ++i)
-      {
-        if( i % this->width == 0 )
-          out << "\n";
+      this->elements.print(out);
+    }
 
-        out << this->data[i] << "\t";
-      }
+    size_t get_width() const
+    {
+      return this->elements.get_rows();
+    }
 
-      out << "\n";
+    // row-major index, unchecked
+    value_type element(size_t index) const
+    {
+      return this->raw_data()[index];
     }
 
-    size_t get_width() const
+    // row-major, get_width() * get_width() elements
+    const value_type * raw_data() const
     {
-      return this->width;
+      return this->elements.raw_data();
+    }
+
+    value_type * raw_data()
+    {
+      return this->elements.raw_data();
+    }
+
+    // for operations on general (rectangular) matrices
+    const matrix<value_type>& as_matrix() const
+    {
+      return this->elements;
     }
 
   private:
+    static size_t checked_width(size_t matrix_width)
+    {
+      if( matrix_width < 1 )
+        throw std::out_of_range("width must be at least 1");
+
+      return matrix_width;
+    }
+
     void swap(square_matrix& left, square_matrix& right) const
     {
       using std::swap;
-      swap(left.width, right.width);
-      swap(left.data, right.data);
+      swap(left.elements, right.elements);
     }
 
-    size_t width;
-    container data;
+    matrix<value_type> elements;
 };
 
 
 }
 
+#include "ds/boolean-square-matrix.h"
+
 #endif
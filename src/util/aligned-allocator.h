@@ -0,0 +1,79 @@
+#ifndef UTIL_ALIGNED_ALLOCATOR_H
+#define UTIL_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace util
+{
+
+// A std::allocator replacement returning memory aligned to alignment bytes
+// (default: a cache line, which also suits every vector register size up
+// to AVX-512).
+template<typename T, size_t alignment = 64>
+class aligned_allocator
+{
+  static_assert(
+    alignment >= sizeof(void *) && (alignment & (alignment - 1)) == 0,
+    "alignment must be a power of two and hold a pointer"
+  );
+
+  public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind
+    {
+      typedef aligned_allocator<U, alignment> other;
+    };
+
+    aligned_allocator() noexcept
+    {
+    }
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, alignment>&) noexcept
+    {
+    }
+
+    T * allocate(size_t num)
+    {
+      if( num > (std::numeric_limits<size_t>::max() - alignment) / sizeof(T) )
+        throw std::bad_alloc();
+
+      // over-allocate, align, and remember the original pointer right in
+      // front of the aligned block
+      void * raw = ::operator new(num * sizeof(T) + alignment);
+      const uintptr_t aligned =
+        (reinterpret_cast<uintptr_t>(raw) + alignment) & ~(alignment - 1);
+
+      void ** block = reinterpret_cast<void **>(aligned);
+      block[-1] = raw;
+
+      return reinterpret_cast<T *>(block);
+    }
+
+    void deallocate(T * ptr, size_t) noexcept
+    {
+      if( ptr )
+        ::operator delete(reinterpret_cast<void **>(ptr)[-1]);
+    }
+
+    template<typename U>
+    bool operator==(const aligned_allocator<U, alignment>&) const noexcept
+    {
+      return true;
+    }
+
+    template<typename U>
+    bool operator!=(const aligned_allocator<U, alignment>&) const noexcept
+    {
+      return false;
+    }
+};
+
+}
+
+#endif // UTIL_ALIGNED_ALLOCATOR_H
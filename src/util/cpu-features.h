@@ -0,0 +1,29 @@
+#ifndef UTIL_CPU_FEATURES_H
+#define UTIL_CPU_FEATURES_H
+
+/*
+ * Instruction set extensions of the cpu the program runs on, for kernels
+ * compiled with __attribute__((target(...))) and chosen at runtime.
+ *
+ */
+
+namespace util {
+
+// true if the cpu supports AVX2; always false but for x86 with gcc/clang
+inline bool cpu_has_avx2()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static const bool supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+
+  return supported;
+#else
+  return false;
+#endif
+}
+
+}
+
+#endif // UTIL_CPU_FEATURES_H
@@ -0,0 +1,115 @@
+#ifndef UTIL_MAPPED_FILE_H
+#define UTIL_MAPPED_FILE_H
+
+/*
+ * A read-only view of a whole file.
+ *
+ * On POSIX systems the file is mapped into memory (mmap), so pages are
+ * read on demand by the kernel and shared with the page cache instead of
+ * being copied; elsewhere the file is read into a buffer.
+ *
+ */
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UTIL_MAPPED_FILE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace util {
+
+class mapped_file
+{
+  public:
+    // throws std::runtime_error if the file cannot be opened or mapped
+    explicit mapped_file(const std::string& path)
+    : begin(nullptr),
+      length(0),
+      buffer()
+    {
+#ifdef UTIL_MAPPED_FILE_MMAP
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if( fd < 0 )
+        throw std::runtime_error("cannot open file " + path);
+
+      struct stat info;
+      if( ::fstat(fd, &info) != 0 )
+      {
+        ::close(fd);
+        throw std::runtime_error("cannot stat file " + path);
+      }
+
+      this->length = static_cast<size_t>(info.st_size);
+
+      // mapping an empty file fails, there is nothing to map anyway
+      if( this->length > 0 )
+      {
+        void * mapped = ::mmap(
+          nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0
+        );
+        if( mapped == MAP_FAILED )
+        {
+          ::close(fd);
+          throw std::runtime_error("cannot map file " + path);
+        }
+
+        ::madvise(mapped, this->length, MADV_SEQUENTIAL);
+        this->begin = static_cast<const char *>(mapped);
+      }
+
+      // the mapping stays valid without the descriptor
+      ::close(fd);
+#else
+      std::ifstream in(path.c_str(), std::ios::binary);
+      if( !in.is_open() )
+        throw std::runtime_error("cannot open file " + path);
+
+      this->buffer.assign(
+        std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>()
+      );
+      this->begin = this->buffer.data();
+      this->length = this->buffer.size();
+#endif
+    }
+
+    ~mapped_file()
+    {
+#ifdef UTIL_MAPPED_FILE_MMAP
+      if( this->begin )
+        ::munmap(const_cast<char *>(this->begin), this->length);
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char * data() const
+    {
+      return this->begin;
+    }
+
+    size_t size() const
+    {
+      return this->length;
+    }
+
+  private:
+    const char * begin;
+    size_t length;
+    // the contents, if the file is not mapped
+    std::vector<char> buffer;
+};
+
+}
+
+#endif // UTIL_MAPPED_FILE_H
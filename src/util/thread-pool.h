@@ -0,0 +1,228 @@
+#ifndef UTIL_THREAD_POOL_H
+#define UTIL_THREAD_POOL_H
+
+/*
+ * A work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted by a worker go to the
+ * back of its own deque and are taken from the back again (LIFO, the data
+ * is still in cache), idle workers steal from the front of other deques
+ * (FIFO, the oldest and usually largest tasks). Tasks submitted from
+ * outside the pool are distributed round-robin.
+ *
+ * A task that waits for tasks it spawned must use thread_pool::wait(),
+ * which runs pending tasks instead of blocking, so nested parallelism
+ * cannot deadlock the pool.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+
+class thread_pool
+{
+  public:
+    explicit thread_pool(
+      size_t num_threads = std::max(1U, std::thread::hardware_concurrency())
+    )
+    : queues(num_threads),
+      threads(),
+      num_pending(0),
+      next_queue(0),
+      stop(false),
+      sleep_mutex(),
+      wake_up()
+    {
+      for(size_t i = 0; i < num_threads; ++i)
+        this->queues[i].reset(new task_queue());
+
+      for(size_t i = 0; i < num_threads; ++i)
+        this->threads.emplace_back(&thread_pool::work, this, i);
+    }
+
+    ~thread_pool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex);
+        this->stop = true;
+      }
+      this->wake_up.notify_all();
+
+      for(auto& thread : this->threads)
+        thread.join();
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    template<typename function>
+    std::future<typename std::result_of<function()>::type>
+    submit(function func)
+    {
+      typedef typename std::result_of<function()>::type result_type;
+
+      auto task = std::make_shared<std::packaged_task<result_type()>>(
+        std::move(func)
+      );
+      std::future<result_type> result(task->get_future());
+
+      const worker_id& self = current_worker();
+      const size_t queue_index = self.pool == this
+        ? self.index
+        : this->next_queue++ % this->queues.size();
+
+      // count the task before it is queued, so taking it can never
+      // decrement num_pending below zero
+      {
+        std::lock_guard<std::mutex> lock(this->sleep_mutex);
+        ++this->num_pending;
+      }
+
+      {
+        task_queue& queue = *this->queues[queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back([task]() { (*task)(); });
+      }
+
+      this->wake_up.notify_one();
+
+      return result;
+    }
+
+    // run pending tasks until result is ready
+    template<typename result_type>
+    void wait(const std::future<result_type>& result)
+    {
+      while( result.wait_for(std::chrono::seconds(0))
+             != std::future_status::ready )
+      {
+        if( !this->run_pending_task() )
+          std::this_thread::yield();
+      }
+    }
+
+    // run a single pending task on the calling thread,
+    // false if there was none
+    bool run_pending_task()
+    {
+      const worker_id& self = current_worker();
+      const size_t first = self.pool == this ? self.index : 0;
+
+      std::function<void()> task;
+      if( !this->take_task(first, task) )
+        return false;
+
+      task();
+      return true;
+    }
+
+    size_t size() const
+    {
+      return this->threads.size();
+    }
+
+  private:
+    struct task_queue
+    {
+      task_queue() : mutex(), tasks() {}
+
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    struct worker_id
+    {
+      const thread_pool * pool;
+      size_t index;
+    };
+
+    static worker_id& current_worker()
+    {
+      thread_local worker_id id = { nullptr, 0 };
+      return id;
+    }
+
+    // pop from the back of queue first, steal from the front of the others
+    bool take_task(size_t first, std::function<void()>& task)
+    {
+      {
+        task_queue& own = *this->queues[first];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if( !own.tasks.empty() )
+        {
+          task = std::move(own.tasks.back());
+          own.tasks.pop_back();
+          --this->num_pending;
+          return true;
+        }
+      }
+
+      for(size_t i = 1; i < this->queues.size(); ++i)
+      {
+        task_queue& other = *this->queues[(first + i) % this->queues.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if( !other.tasks.empty() )
+        {
+          task = std::move(other.tasks.front());
+          other.tasks.pop_front();
+          --this->num_pending;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void work(size_t index)
+    {
+      worker_id& self = current_worker();
+      self.pool = this;
+      self.index = index;
+
+      std::function<void()> task;
+      while( true )
+      {
+        if( this->take_task(index, task) )
+        {
+          task();
+          continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->sleep_mutex);
+        this->wake_up.wait(lock, [this]() {
+          return this->stop || this->num_pending > 0;
+        });
+
+        // finish all queued tasks before stopping
+        if( this->stop && this->num_pending == 0 )
+          return;
+      }
+    }
+
+    std::vector<std::unique_ptr<task_queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> num_pending;
+    std::atomic<size_t> next_queue;
+    bool stop;
+    std::mutex sleep_mutex;
+    std::condition_variable wake_up;
+};
+
+}
+
+#endif // UTIL_THREAD_POOL_H
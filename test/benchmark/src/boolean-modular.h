@@ -0,0 +1,122 @@
+#ifndef BENCHMARK_BOOLEAN_MODULAR_H
+#define BENCHMARK_BOOLEAN_MODULAR_H
+
+/*
+ * Runtime of the Boolean product of ds::square_matrix<bool> vs. the same
+ * product as an int matrix with al::strassen_matrix_multiply; and of
+ * al::modular_matrix_multiply vs. reducing every product and, where the
+ * products cannot overflow, vs. al::strassen_matrix_multiply on long long
+ * with a single reduction at the end.
+ *
+ * CSV rows: boolean,width,variant,seconds
+ *           modular,modulus,width,variant,seconds
+ *
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "ds/square-matrix.h"
+#include "al/modular-matrix-multiply.h"
+#include "al/strassen-matrix-multiply.h"
+
+#include "timer.h"
+
+namespace bench {
+
+inline void boolean_for_width(size_t width, std::ostream& out)
+{
+  ds::square_matrix<bool> l(width), r(width);
+  ds::square_matrix<int> li(width), ri(width);
+  for(size_t row = 0; row < width; ++row)
+    for(size_t col = 0; col < width; ++col)
+    {
+      const bool a = std::rand() % 10 == 0;
+      const bool b = std::rand() % 10 == 0;
+      l.set(row, col, a);
+      r.set(row, col, b);
+      li.set(row, col, a);
+      ri.set(row, col, b);
+    }
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "boolean," << width << "," << variant << "," << seconds
+        << std::endl;
+  };
+
+  print("four-russians", best_of(3, [&]() {
+    do_not_optimize(l * r);
+  }));
+  print("strassen-int", best_of(3, [&]() {
+    const ds::square_matrix<int> p(al::strassen_matrix_multiply(li, ri));
+    ds::square_matrix<bool> result(width);
+    for(size_t row = 0; row < width; ++row)
+      for(size_t col = 0; col < width; ++col)
+        result.set(row, col, p.get(row, col) > 0);
+    do_not_optimize(result);
+  }));
+}
+
+inline void modular_for_width(uint32_t modulus, size_t width, std::ostream& out)
+{
+  ds::square_matrix<long long> l(width), r(width);
+  for(size_t i = 0; i < width * width; ++i)
+  {
+    l.raw_data()[i] = static_cast<long long>(
+      (uint64_t(std::rand()) << 16 ^ uint64_t(std::rand())) % modulus);
+    r.raw_data()[i] = static_cast<long long>(
+      (uint64_t(std::rand()) << 16 ^ uint64_t(std::rand())) % modulus);
+  }
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "modular," << modulus << "," << width << "," << variant << ","
+        << seconds << std::endl;
+  };
+
+  print("delayed-reduction", best_of(3, [&]() {
+    do_not_optimize(al::modular_matrix_multiply(l, r, modulus));
+  }));
+  print("reduce-every-product", best_of(3, [&]() {
+    ds::square_matrix<long long> result(width);
+    const long long * a = l.raw_data();
+    const long long * b = r.raw_data();
+    long long * c = result.raw_data();
+    for(size_t i = 0; i < width; ++i)
+      for(size_t k = 0; k < width; ++k)
+        for(size_t j = 0; j < width; ++j)
+          c[i * width + j] =
+            (c[i * width + j] + a[i * width + k] * b[k * width + j]) % modulus;
+    do_not_optimize(result);
+  }));
+
+  // width * (modulus - 1)^2 must fit a long long
+  const double max_sum = double(width) * double(modulus - 1) * (modulus - 1);
+  if( max_sum < 9.2e18 )
+  {
+    print("strassen-then-reduce", best_of(3, [&]() {
+      ds::square_matrix<long long> result(al::strassen_matrix_multiply(l, r));
+      for(size_t i = 0; i < width * width; ++i)
+        result.raw_data()[i] %= modulus;
+      do_not_optimize(result);
+    }));
+  }
+}
+
+inline void boolean_modular(std::ostream& out)
+{
+  const size_t boolean_widths[] = { 256, 1024, 2048 };
+  for(auto width : boolean_widths)
+    boolean_for_width(width, out);
+
+  const uint32_t moduli[] = { 65521, 1000000007u };
+  const size_t modular_widths[] = { 256, 1024 };
+  for(auto modulus : moduli)
+    for(auto width : modular_widths)
+      modular_for_width(modulus, width, out);
+}
+
+}
+
+#endif // BENCHMARK_BOOLEAN_MODULAR_H
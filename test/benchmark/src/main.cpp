@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "strassen-crossover.h"
+#include "parallel-strassen.h"
+#include "strassen-layout.h"
+#include "sparse-matrix.h"
+#include "small-matrix.h"
+#include "strassen-memory.h"
+#include "multiply-accuracy.h"
+#include "boolean-modular.h"
+#include "matrix-power.h"
+#include "string-search.h"
+#include "substring-selection.h"
+
+struct BenchmarkInfo
+{
+  void (*run)(std::ostream&);
+  const char * name;
+  const char * desc;
+};
+
+BenchmarkInfo g_benchmarks[] =
+{
+  { bench::strassen_crossover, "strassen-crossover",
+      "al::strassen_matrix_multiply runtime by crossover width, int/double" },
+  { bench::parallel_strassen, "parallel-strassen",
+      "al::parallel_strassen_matrix_multiply runtime by number of threads" },
+  { bench::strassen_layout, "strassen-layout",
+      "al::strassen_matrix_multiply vs. al::morton_strassen_matrix_multiply" },
+  { bench::sparse_matrix, "sparse-matrix",
+      "ds::sparse_matrix products vs. the dense products, by density" },
+  { bench::small_matrix, "small-matrix",
+      "batches of small matrix products and matrix-vector products" },
+  { bench::strassen_memory, "strassen-memory",
+      "runtime and peak memory of al::strassen_matrix_multiply vs. "
+      "al::winograd_matrix_multiply" },
+  { bench::multiply_accuracy, "multiply-accuracy",
+      "error and runtime of al::matrix_multiply by multiply_policy" },
+  { bench::boolean_modular, "boolean-modular",
+      "Boolean products of ds::square_matrix<bool> and "
+      "al::modular_matrix_multiply vs. the generic products" },
+  { bench::matrix_power, "matrix-power",
+      "al::matrix_power and al::matrix_chain_multiply vs. operator*" },
+  { bench::string_search, "string-search",
+      "throughput of finding all occurrences of a pattern, by algorithm" },
+  { bench::substring_selection, "substring-selection",
+      "one-off and repeated substring searches in the sample text, by "
+      "algorithm and pattern length" }
+};
+
+const size_t g_num_benchmarks = sizeof(g_benchmarks) / sizeof(BenchmarkInfo);
+
+void print_usage(const char * name)
+{
+  std::cout << "Usage: " << name << " [BENCHMARK...]" << "\n"
+            << "Runs the given benchmarks (default: all), prints CSV to stdout"
+            << "\n\n" << "Available benchmarks:" << "\n";
+
+  for(size_t i = 0; i < g_num_benchmarks; ++i)
+    std::cout << "  " << g_benchmarks[i].name << "\n"
+              << "    " << g_benchmarks[i].desc << "\n";
+
+  std::cout << std::flush;
+}
+
+const BenchmarkInfo * find_benchmark(const char * name)
+{
+  for(size_t i = 0; i < g_num_benchmarks; ++i)
+    if( std::strcmp(g_benchmarks[i].name, name) == 0 )
+      return &g_benchmarks[i];
+
+  return nullptr;
+}
+
+int main(int argc, char * argv[])
+{
+  for(int i = 1; i < argc; ++i)
+  {
+    if( find_benchmark(argv[i]) == nullptr )
+    {
+      print_usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if( argc < 2 )
+  {
+    for(size_t i = 0; i < g_num_benchmarks; ++i)
+      g_benchmarks[i].run(std::cout);
+  }
+  else
+  {
+    for(int i = 1; i < argc; ++i)
+      find_benchmark(argv[i])->run(std::cout);
+  }
+
+  return EXIT_SUCCESS;
+}
+
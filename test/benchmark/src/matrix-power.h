@@ -0,0 +1,104 @@
+#ifndef BENCHMARK_MATRIX_POWER_H
+#define BENCHMARK_MATRIX_POWER_H
+
+/*
+ * Runtime of al::matrix_power vs. repeated squaring with operator*, which
+ * allocates a result and recursion temporaries per product; and of
+ * al::matrix_chain_multiply vs. multiplying the chain left to right.
+ *
+ * CSV rows: matrix-power,width,exponent,variant,seconds
+ *           matrix-chain,dims,variant,seconds
+ *
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "ds/matrix.h"
+#include "ds/square-matrix.h"
+#include "al/matrix-chain-multiply.h"
+#include "al/matrix-power.h"
+
+#include "strassen-crossover.h"
+#include "timer.h"
+
+namespace bench {
+
+inline void matrix_power_for_width(
+  size_t width,
+  unsigned long long exponent,
+  std::ostream& out
+)
+{
+  // a stochastic matrix, the powers stay bounded
+  ds::square_matrix<double> m(width);
+  for(size_t row = 0; row < width; ++row)
+    for(size_t col = 0; col < width; ++col)
+      m.set(row, col, 1.0 / static_cast<double>(width));
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "matrix-power," << width << "," << exponent << "," << variant
+        << "," << seconds << std::endl;
+  };
+
+  print("operator*", best_of(3, [&]() {
+    ds::square_matrix<double> power(m);
+    ds::square_matrix<double> result(m);
+    for(unsigned long long e = exponent - 1; e; e >>= 1)
+    {
+      if( e & 1 )
+        result = result * power;
+      if( e > 1 )
+        power = power * power;
+    }
+    do_not_optimize(result);
+  }));
+  print("matrix_power", best_of(3, [&]() {
+    do_not_optimize(al::matrix_power(m, exponent));
+  }));
+}
+
+inline void matrix_chain(std::ostream& out)
+{
+  const std::vector<size_t> dims = { 1000, 20, 1000, 20, 1000, 1 };
+
+  std::vector<ds::matrix<double>> chain;
+  for(size_t i = 0; i + 1 < dims.size(); ++i)
+  {
+    ds::matrix<double> m(dims[i], dims[i + 1]);
+    for(size_t r = 0; r < dims[i]; ++r)
+      for(size_t c = 0; c < dims[i + 1]; ++c)
+        m.set(r, c, static_cast<double>((r + c) % 7));
+    chain.push_back(m);
+  }
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "matrix-chain,";
+    for(size_t i = 0; i < dims.size(); ++i)
+      out << (i ? "x" : "") << dims[i];
+    out << "," << variant << "," << seconds << std::endl;
+  };
+
+  print("left-to-right", best_of(3, [&]() {
+    ds::matrix<double> product(chain[0]);
+    for(size_t i = 1; i < chain.size(); ++i)
+      product = product * chain[i];
+    do_not_optimize(product);
+  }));
+  print("matrix_chain_multiply", best_of(3, [&]() {
+    do_not_optimize(al::matrix_chain_multiply(chain));
+  }));
+}
+
+inline void matrix_power(std::ostream& out)
+{
+  const size_t widths[] = { 64, 256, 1024 };
+  for(auto width : widths)
+    matrix_power_for_width(width, 100, out);
+
+  matrix_chain(out);
+}
+
+}
+
+#endif // BENCHMARK_MATRIX_POWER_H
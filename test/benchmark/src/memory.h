@@ -0,0 +1,57 @@
+#ifndef BENCHMARK_MEMORY_H
+#define BENCHMARK_MEMORY_H
+
+/*
+ * Resident set size of this process, read from /proc/self/status (Linux);
+ * -1 where that isn't available.
+ *
+ */
+
+#include <fstream>
+#include <string>
+
+#if defined(__GLIBC__)
+  #include <malloc.h>
+#endif
+
+namespace bench {
+
+// a "Name:   1234 kB" line of /proc/self/status, in KiB
+inline long proc_status_kib(const std::string& name)
+{
+  std::ifstream status("/proc/self/status");
+
+  std::string line;
+  while( std::getline(status, line) )
+    if( line.compare(0, name.size() + 1, name + ":") == 0 )
+      return std::stol(line.substr(name.size() + 1));
+
+  return -1;
+}
+
+inline long current_rss_kib()
+{
+  return proc_status_kib("VmRSS");
+}
+
+// the highest RSS since the last reset_peak_rss()
+inline long peak_rss_kib()
+{
+  return proc_status_kib("VmHWM");
+}
+
+// Also returns free heap memory to the system; otherwise a later
+// allocation reuses pages that are still resident and doesn't show up.
+inline void reset_peak_rss()
+{
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+}
+
+}
+
+#endif // BENCHMARK_MEMORY_H
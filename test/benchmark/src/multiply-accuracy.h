@@ -0,0 +1,131 @@
+#ifndef BENCHMARK_MULTIPLY_ACCURACY_H
+#define BENCHMARK_MULTIPLY_ACCURACY_H
+
+/*
+ * Error and runtime of al::matrix_multiply with every multiply_policy, on
+ * matrices of doubles uniformly distributed in [-1, 1].
+ *
+ * The error is max |C - R| / max (|A| |B|) over all elements, with R
+ * computed classically in long double; it's about 1e-16 (one rounding)
+ * for an ideal algorithm and grows with the width and the number of
+ * strassen levels.
+ *
+ * CSV rows: multiply-accuracy,width,policy,seconds,error
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ds/square-matrix.h"
+#include "al/matrix-multiply-policy.h"
+
+#include "timer.h"
+
+namespace bench {
+
+inline ds::square_matrix<double> uniform_square_matrix(
+  size_t width,
+  std::mt19937& generator
+)
+{
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  ds::square_matrix<double> m(width);
+  double * data = m.raw_data();
+  for(size_t i = 0; i < width * width; ++i)
+    data[i] = distribution(generator);
+
+  return m;
+}
+
+// max |C - left * right| / max (|left| |right|), the exact product
+// approximated in long double
+inline double relative_product_error(
+  const ds::square_matrix<double>& left,
+  const ds::square_matrix<double>& right,
+  const ds::square_matrix<double>& product
+)
+{
+  const size_t width = left.get_width();
+  const double * a = left.raw_data();
+  const double * b = right.raw_data();
+
+  std::vector<long double> exact(width), magnitude(width);
+  double max_error = 0;
+  double max_magnitude = 0;
+
+  for(size_t i = 0; i < width; ++i)
+  {
+    std::fill(exact.begin(), exact.end(), 0.0L);
+    std::fill(magnitude.begin(), magnitude.end(), 0.0L);
+
+    for(size_t k = 0; k < width; ++k)
+    {
+      const long double factor = a[i * width + k];
+      for(size_t j = 0; j < width; ++j)
+      {
+        exact[j] += factor * b[k * width + j];
+        magnitude[j] += std::fabs(factor * b[k * width + j]);
+      }
+    }
+
+    for(size_t j = 0; j < width; ++j)
+    {
+      const long double error = product.raw_data()[i * width + j] - exact[j];
+      max_error = std::max(max_error, static_cast<double>(std::fabs(error)));
+      max_magnitude =
+        std::max(max_magnitude, static_cast<double>(magnitude[j]));
+    }
+  }
+
+  return max_error / max_magnitude;
+}
+
+inline void multiply_accuracy(std::ostream& out)
+{
+  const size_t widths[] = { 256, 512, 1024 };
+
+  struct named_policy
+  {
+    const char * name;
+    al::multiply_policy policy;
+  };
+
+  const named_policy policies[] = {
+    { "blocked", al::blocked_policy() },
+    { "kahan", al::kahan_policy() },
+    { "strassen-depth-1", al::strassen_policy(1) },
+    { "strassen-depth-2", al::strassen_policy(2) },
+    { "strassen-depth-3", al::strassen_policy(3) },
+    { "strassen", al::strassen_policy() }
+  };
+
+  std::mt19937 generator(42);
+  for(auto width : widths)
+  {
+    const auto left = uniform_square_matrix(width, generator);
+    const auto right = uniform_square_matrix(width, generator);
+
+    for(const auto& p : policies)
+    {
+      const double seconds = best_of(3, [&]() {
+        do_not_optimize(al::matrix_multiply(left, right, p.policy));
+      });
+      const double error = relative_product_error(
+        left, right, al::matrix_multiply(left, right, p.policy)
+      );
+
+      out << "multiply-accuracy," << width << "," << p.name << ","
+          << seconds << "," << error << std::endl;
+    }
+  }
+}
+
+}
+
+#endif // BENCHMARK_MULTIPLY_ACCURACY_H
@@ -0,0 +1,53 @@
+#ifndef BENCHMARK_PARALLEL_STRASSEN_H
+#define BENCHMARK_PARALLEL_STRASSEN_H
+
+/*
+ * Runtime of al::parallel_strassen_matrix_multiply by number of threads,
+ * 1 thread up to std::thread::hardware_concurrency().
+ *
+ * CSV rows: parallel-strassen,type,width,threads,seconds
+ *
+ */
+
+#include <iostream>
+#include <thread>
+
+#include "ds/square-matrix.h"
+#include "al/parallel-strassen-matrix-multiply.h"
+#include "util/thread-pool.h"
+
+#include "strassen-crossover.h"
+#include "timer.h"
+
+namespace bench {
+
+inline void parallel_strassen(std::ostream& out)
+{
+  const size_t widths[] = { 1024, 2048, 4096 };
+  const size_t max_threads =
+    std::max(1U, std::thread::hardware_concurrency());
+
+  for(auto width : widths)
+  {
+    const auto left = random_square_matrix<double>(width);
+    const auto right = random_square_matrix<double>(width);
+
+    for(size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+      util::thread_pool pool(threads);
+
+      const double seconds = best_of(3, [&]() {
+        do_not_optimize(
+          al::parallel_strassen_matrix_multiply(left, right, pool)
+        );
+      });
+
+      out << "parallel-strassen,double," << width << "," << threads << ","
+          << seconds << std::endl;
+    }
+  }
+}
+
+}
+
+#endif // BENCHMARK_PARALLEL_STRASSEN_H
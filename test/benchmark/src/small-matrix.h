@@ -0,0 +1,127 @@
+#ifndef BENCHMARK_SMALL_MATRIX_H
+#define BENCHMARK_SMALL_MATRIX_H
+
+/*
+ * Runtime of multiplying a batch of small matrices with
+ * al::strassen_matrix_multiply, al::blocked_matrix_multiply and the
+ * unrolled kernels of al::batched_matrix_multiply (returning new
+ * matrices, or into the matrices of the previous batch) and
+ * al::mm::batched_multiply; and of matrix-vector
+ * products with ds::square_matrix vs. a plain loop.
+ *
+ * CSV rows: small-matrix,type,width,count,variant,seconds
+ *           gemv,type,width,variant,seconds
+ *
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "ds/square-matrix.h"
+#include "al/blocked-matrix-multiply.h"
+#include "al/small-matrix-multiply.h"
+#include "al/strassen-matrix-multiply.h"
+
+#include "strassen-crossover.h"
+#include "timer.h"
+
+namespace bench {
+
+template<typename value_type>
+void small_matrix_for_width(
+  const char * type_name,
+  size_t width,
+  std::ostream& out
+)
+{
+  const size_t count = 100000;
+  const size_t size = width * width;
+
+  std::vector<ds::square_matrix<value_type>> left, right;
+  std::vector<value_type> packed_left(count * size), packed_right(count * size);
+  for(size_t i = 0; i < count; ++i)
+  {
+    left.push_back(random_square_matrix<value_type>(width));
+    right.push_back(random_square_matrix<value_type>(width));
+    std::copy(left[i].raw_data(), left[i].raw_data() + size,
+      packed_left.begin() + static_cast<std::ptrdiff_t>(i * size));
+    std::copy(right[i].raw_data(), right[i].raw_data() + size,
+      packed_right.begin() + static_cast<std::ptrdiff_t>(i * size));
+  }
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "small-matrix," << type_name << "," << width << "," << count << ","
+        << variant << "," << seconds << std::endl;
+  };
+
+  print("strassen", best_of(3, [&]() {
+    for(size_t i = 0; i < count; ++i)
+      do_not_optimize(al::strassen_matrix_multiply(left[i], right[i]));
+  }));
+  print("blocked", best_of(3, [&]() {
+    for(size_t i = 0; i < count; ++i)
+      do_not_optimize(al::blocked_matrix_multiply(left[i], right[i]));
+  }));
+  print("batched", best_of(3, [&]() {
+    do_not_optimize(al::batched_matrix_multiply(left, right));
+  }));
+
+  std::vector<ds::square_matrix<value_type>> products;
+  print("batched-into", best_of(3, [&]() {
+    al::batched_matrix_multiply(left, right, products);
+    do_not_optimize(products);
+  }));
+
+  std::vector<value_type> packed_out(count * size);
+  print("batched-contiguous", best_of(3, [&]() {
+    al::mm::batched_multiply(
+      width, packed_left.data(), packed_right.data(), packed_out.data(), count
+    );
+    do_not_optimize(packed_out);
+  }));
+}
+
+template<typename value_type>
+void gemv_for_width(const char * type_name, size_t width, std::ostream& out)
+{
+  const auto matrix = random_square_matrix<value_type>(width);
+  const std::vector<value_type> x(width, value_type(1));
+
+  const double loop = best_of(3, [&]() {
+    std::vector<value_type> y(width);
+    const value_type * data = matrix.raw_data();
+    for(size_t row = 0; row < width; ++row)
+      for(size_t col = 0; col < width; ++col)
+        y[row] += data[row * width + col] * x[col];
+    do_not_optimize(y);
+  });
+  const double kernel = best_of(3, [&]() {
+    do_not_optimize(matrix * x);
+  });
+
+  out << "gemv," << type_name << "," << width << ",loop," << loop
+      << std::endl;
+  out << "gemv," << type_name << "," << width << ",gemv-kernel," << kernel
+      << std::endl;
+}
+
+inline void small_matrix(std::ostream& out)
+{
+  const size_t widths[] = { 4, 8, 16 };
+  for(auto width : widths)
+  {
+    small_matrix_for_width<float>("float", width, out);
+    small_matrix_for_width<double>("double", width, out);
+  }
+
+  const size_t gemv_widths[] = { 256, 2048, 8192 };
+  for(auto width : gemv_widths)
+  {
+    gemv_for_width<float>("float", width, out);
+    gemv_for_width<double>("double", width, out);
+  }
+}
+
+}
+
+#endif // BENCHMARK_SMALL_MATRIX_H
@@ -0,0 +1,119 @@
+#ifndef BENCHMARK_SPARSE_MATRIX_H
+#define BENCHMARK_SPARSE_MATRIX_H
+
+/*
+ * Runtime of sparse matrix-vector and matrix-matrix products (sequential
+ * and on a thread pool with hardware_concurrency threads) vs. the dense
+ * products of the same matrices, for a few densities.
+ *
+ * CSV rows: sparse-matrix,product,width,density,variant,seconds
+ * with product mv or mm, variant dense, sparse or parallel-sparse
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "ds/sparse-matrix.h"
+#include "ds/square-matrix.h"
+#include "al/parallel-sparse-matrix-multiply.h"
+#include "util/thread-pool.h"
+
+#include "timer.h"
+
+namespace bench {
+
+// about density * width * width non-zeros at random positions
+inline ds::sparse_matrix<double> random_sparse_matrix(
+  size_t width,
+  double density
+)
+{
+  const size_t nonzeros = static_cast<size_t>(
+    density * static_cast<double>(width) * static_cast<double>(width)
+  );
+
+  std::vector<ds::sparse_entry<double>> entries;
+  entries.reserve(nonzeros);
+  for(size_t i = 0; i < nonzeros; ++i)
+  {
+    entries.push_back({
+      static_cast<size_t>(std::rand()) % width,
+      static_cast<size_t>(std::rand()) % width,
+      static_cast<double>(std::rand() % 100 + 1)
+    });
+  }
+
+  return ds::sparse_matrix<double>(width, width, entries);
+}
+
+inline void print_sparse_row(
+  std::ostream& out,
+  const char * product,
+  size_t width,
+  double density,
+  const char * variant,
+  double seconds
+)
+{
+  out << "sparse-matrix," << product << "," << width << "," << density << ","
+      << variant << "," << seconds << std::endl;
+}
+
+inline void sparse_matrix(std::ostream& out)
+{
+  const size_t widths[] = { 1024, 2048 };
+  const double densities[] = { 0.001, 0.01, 0.1 };
+
+  util::thread_pool pool;
+
+  for(auto width : widths)
+  {
+    for(auto density : densities)
+    {
+      const auto left = random_sparse_matrix(width, density);
+      const auto right = random_sparse_matrix(width, density);
+      const auto dense_left = left.to_square_matrix();
+      const auto dense_right = right.to_square_matrix();
+      const std::vector<double> x(width, 1.0);
+
+      print_sparse_row(out, "mv", width, density, "dense", best_of(3, [&]() {
+        std::vector<double> y(width);
+        const double * data = dense_left.raw_data();
+        for(size_t row = 0; row < width; ++row)
+          for(size_t col = 0; col < width; ++col)
+            y[row] += data[row * width + col] * x[col];
+        do_not_optimize(y);
+      }));
+      print_sparse_row(out, "mv", width, density, "sparse", best_of(3, [&]() {
+        do_not_optimize(left * x);
+      }));
+      print_sparse_row(out, "mv", width, density, "parallel-sparse",
+        best_of(3, [&]() {
+          do_not_optimize(
+            al::parallel_sparse_matrix_vector_multiply(left, x, pool)
+          );
+        })
+      );
+
+      print_sparse_row(out, "mm", width, density, "dense", best_of(3, [&]() {
+        do_not_optimize(dense_left * dense_right);
+      }));
+      print_sparse_row(out, "mm", width, density, "sparse", best_of(3, [&]() {
+        do_not_optimize(left * right);
+      }));
+      print_sparse_row(out, "mm", width, density, "parallel-sparse",
+        best_of(3, [&]() {
+          do_not_optimize(
+            al::parallel_sparse_matrix_multiply(left, right, pool)
+          );
+        })
+      );
+    }
+  }
+}
+
+}
+
+#endif // BENCHMARK_SPARSE_MATRIX_H
@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_STRASSEN_CROSSOVER_H
+#define BENCHMARK_STRASSEN_CROSSOVER_H
+
+/*
+ * Runtime of al::strassen_matrix_multiply for several crossover widths,
+ * to pick al::strassen_crossover<value_type>::value.
+ *
+ * CSV rows: strassen-crossover,type,width,crossover,seconds
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include "ds/square-matrix.h"
+#include "al/strassen-matrix-multiply.h"
+
+#include "timer.h"
+
+namespace bench {
+
+template<typename value_type>
+ds::square_matrix<value_type> random_square_matrix(size_t width)
+{
+  ds::square_matrix<value_type> m(width);
+  value_type * data = m.raw_data();
+  for(size_t i = 0; i < width * width; ++i)
+    data[i] = static_cast<value_type>(std::rand() % 100);
+
+  return m;
+}
+
+template<typename value_type>
+void strassen_crossover_for_type(const char * type_name, std::ostream& out)
+{
+  const size_t widths[] = { 256, 512, 1024, 2048 };
+  const size_t crossovers[] = { 16, 32, 64, 128, 256, 512 };
+
+  for(auto width : widths)
+  {
+    const auto left = random_square_matrix<value_type>(width);
+    const auto right = random_square_matrix<value_type>(width);
+
+    for(auto crossover : crossovers)
+    {
+      if( crossover > width )
+        continue;
+
+      const double seconds = best_of(3, [&]() {
+        do_not_optimize(al::strassen_matrix_multiply(left, right, crossover));
+      });
+
+      out << "strassen-crossover," << type_name << "," << width << ","
+          << crossover << "," << seconds << std::endl;
+    }
+  }
+}
+
+inline void strassen_crossover(std::ostream& out)
+{
+  strassen_crossover_for_type<int>("int", out);
+  strassen_crossover_for_type<double>("double", out);
+}
+
+}
+
+#endif // BENCHMARK_STRASSEN_CROSSOVER_H
@@ -0,0 +1,55 @@
+#ifndef BENCHMARK_STRASSEN_LAYOUT_H
+#define BENCHMARK_STRASSEN_LAYOUT_H
+
+/*
+ * Runtime of al::strassen_matrix_multiply (row-major quadrant views) vs.
+ * al::morton_strassen_matrix_multiply (Morton layout, including the
+ * conversions).
+ *
+ * CSV rows: strassen-layout,type,width,layout,seconds
+ *
+ */
+
+#include <iostream>
+
+#include "ds/square-matrix.h"
+#include "al/strassen-matrix-multiply.h"
+
+#include "strassen-crossover.h"
+#include "timer.h"
+
+namespace bench {
+
+template<typename value_type>
+void strassen_layout_for_type(const char * type_name, std::ostream& out)
+{
+  const size_t widths[] = { 512, 1025, 2048 };
+
+  for(auto width : widths)
+  {
+    const auto left = random_square_matrix<value_type>(width);
+    const auto right = random_square_matrix<value_type>(width);
+
+    const double row_major = best_of(3, [&]() {
+      do_not_optimize(al::strassen_matrix_multiply(left, right));
+    });
+    const double morton = best_of(3, [&]() {
+      do_not_optimize(al::morton_strassen_matrix_multiply(left, right));
+    });
+
+    out << "strassen-layout," << type_name << "," << width << ",row-major,"
+        << row_major << std::endl;
+    out << "strassen-layout," << type_name << "," << width << ",morton,"
+        << morton << std::endl;
+  }
+}
+
+inline void strassen_layout(std::ostream& out)
+{
+  strassen_layout_for_type<int>("int", out);
+  strassen_layout_for_type<double>("double", out);
+}
+
+}
+
+#endif // BENCHMARK_STRASSEN_LAYOUT_H
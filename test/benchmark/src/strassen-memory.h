@@ -0,0 +1,77 @@
+#ifndef BENCHMARK_STRASSEN_MEMORY_H
+#define BENCHMARK_STRASSEN_MEMORY_H
+
+/*
+ * Runtime and peak memory of al::strassen_matrix_multiply (scratch memory
+ * allocated on every level) vs. al::winograd_matrix_multiply (one
+ * workspace for all levels, which also holds the zero padded operands and
+ * product of e.g. width 1025).
+ *
+ * peak_kib is the peak resident set size during one multiplication minus
+ * the resident set size before it, i.e. the memory for the result and all
+ * temporaries; -1 if the platform doesn't tell.
+ *
+ * CSV rows: strassen-memory,type,width,variant,seconds,peak_kib
+ *
+ */
+
+#include <iostream>
+
+#include "ds/square-matrix.h"
+#include "al/strassen-matrix-multiply.h"
+#include "al/winograd-matrix-multiply.h"
+
+#include "memory.h"
+#include "strassen-crossover.h"
+#include "timer.h"
+
+namespace bench {
+
+template<typename function>
+long extra_peak_rss_kib(function func)
+{
+  reset_peak_rss();
+  const long before = current_rss_kib();
+  func();
+  const long peak = peak_rss_kib();
+
+  return before < 0 || peak < 0 ? -1 : peak - before;
+}
+
+template<typename value_type>
+void strassen_memory_for_type(const char * type_name, std::ostream& out)
+{
+  const size_t widths[] = { 1024, 1025, 2048 };
+
+  for(auto width : widths)
+  {
+    const auto left = random_square_matrix<value_type>(width);
+    const auto right = random_square_matrix<value_type>(width);
+
+    const auto strassen = [&]() {
+      do_not_optimize(al::strassen_matrix_multiply(left, right));
+    };
+    const auto winograd = [&]() {
+      do_not_optimize(al::winograd_matrix_multiply(left, right));
+    };
+
+    // memory first, before the timing runs have touched any heap pages
+    const long strassen_kib = extra_peak_rss_kib(strassen);
+    const long winograd_kib = extra_peak_rss_kib(winograd);
+
+    out << "strassen-memory," << type_name << "," << width << ",strassen,"
+        << best_of(3, strassen) << "," << strassen_kib << std::endl;
+    out << "strassen-memory," << type_name << "," << width << ",winograd,"
+        << best_of(3, winograd) << "," << winograd_kib << std::endl;
+  }
+}
+
+inline void strassen_memory(std::ostream& out)
+{
+  strassen_memory_for_type<int>("int", out);
+  strassen_memory_for_type<double>("double", out);
+}
+
+}
+
+#endif // BENCHMARK_STRASSEN_MEMORY_H
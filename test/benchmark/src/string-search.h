@@ -0,0 +1,289 @@
+#ifndef BENCHMARK_STRING_SEARCH_H
+#define BENCHMARK_STRING_SEARCH_H
+
+/*
+ * Throughput of finding all occurrences of a pattern in a text of random
+ * words: al::boyer_moore_substring::find_all (compact and ptrdiff_t skip
+ * tables) vs. repeated std::string::find and std::search, with
+ * bm::ascii_case_fold vs. lowercasing a copy of the text,
+ * al::stream_searcher fed in chunks and al::parallel_find_all on a thread
+ * pool with a thread per core; and al::simd_substring::find_all. For
+ * many patterns at once, al::aho_corasick vs. one boyer_moore_substring
+ * pass per pattern. For char32_t text, the
+ * flat and the dynamic skip table vs. the same search on char.
+ *
+ * CSV rows: string-search,pattern_length,variant,matches,mib_per_second
+ *           multi-pattern,num_patterns,variant,matches,mib_per_second
+ *           wide-search,pattern_length,variant,matches,mchars_per_second
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "al/aho-corasick.h"
+#include "al/boyer-moore-substring.h"
+#include "al/bm/static-skip-table.h"
+#include "al/parallel-grep.h"
+#include "al/simd-substring.h"
+#include "al/stream-searcher.h"
+#include "util/thread-pool.h"
+
+#include "timer.h"
+
+namespace bench {
+
+// words of 2 to 9 lowercase letters, separated by spaces and newlines
+inline std::string random_text(size_t size)
+{
+  std::string text;
+  text.reserve(size + 16);
+  while( text.size() < size )
+  {
+    for(int i = 2 + std::rand() % 8; i > 0; --i)
+      text.push_back(static_cast<char>('a' + std::rand() % 26));
+    text.push_back(std::rand() % 10 ? ' ' : '\n');
+  }
+
+  text.resize(size);
+  return text;
+}
+
+inline void string_search_for_pattern(
+  const std::string& text,
+  const std::string& pattern,
+  std::ostream& out
+)
+{
+  const auto print = [&](const char * variant, size_t matches, double s) {
+    out << "string-search," << pattern.size() << "," << variant << ","
+        << matches << "," << (double(text.size()) / (1 << 20)) / s
+        << std::endl;
+  };
+
+  const char * t_begin = text.data();
+  const char * t_end = t_begin + text.size();
+
+  size_t matches = 0;
+  const auto count = [&matches](const char *) { ++matches; };
+
+  const auto run = [&](const char * variant, std::function<void()> func) {
+    double seconds = best_of(3, [&]() {
+      matches = 0;
+      func();
+    });
+    print(variant, matches, seconds);
+  };
+
+  run("std::string::find", [&]() {
+    for(size_t pos = text.find(pattern);
+        pos != std::string::npos;
+        pos = text.find(pattern, pos + 1))
+      ++matches;
+  });
+  run("std::search", [&]() {
+    for(const char * it = t_begin;
+        (it = std::search(it, t_end, pattern.begin(), pattern.end())) != t_end;
+        ++it)
+      ++matches;
+  });
+
+  const al::boyer_moore_substring<const char *> bm(
+    pattern.data(), pattern.data() + pattern.size()
+  );
+  run("boyer-moore find_all", [&]() {
+    bm.find_all(t_begin, t_end, count);
+  });
+  const al::boyer_moore_substring<
+    const char *,
+    std::ptrdiff_t,
+    char,
+    al::bm::static_skip_table<char, std::ptrdiff_t>
+  > bm_wide_table(pattern.data(), pattern.data() + pattern.size());
+  run("boyer-moore ptrdiff_t table", [&]() {
+    bm_wide_table.find_all(t_begin, t_end, count);
+  });
+
+  // case-insensitive: the text is lowercase, the pattern uppercase
+  std::string upper(pattern);
+  std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+  run("tolower copy + boyer-moore", [&]() {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    std::string lower_pattern(upper);
+    std::transform(lower_pattern.begin(), lower_pattern.end(),
+      lower_pattern.begin(), ::tolower);
+
+    const al::boyer_moore_substring<const char *> lower_bm(
+      lower_pattern.data(), lower_pattern.data() + lower_pattern.size()
+    );
+    lower_bm.find_all(lower.data(), lower.data() + lower.size(), count);
+  });
+  const al::boyer_moore_substring<
+    const char *,
+    std::ptrdiff_t,
+    char,
+    al::bm::default_skip_table<char, std::ptrdiff_t>::type,
+    al::bm::ascii_case_fold
+  > icase_bm(upper.data(), upper.data() + upper.size());
+  run("boyer-moore case-insensitive", [&]() {
+    icase_bm.find_all(t_begin, t_end, count);
+  });
+  run("boyer-moore stream 64KiB", [&]() {
+    al::stream_searcher<al::boyer_moore_substring<const char *>> stream(bm);
+    for(size_t pos = 0; pos < text.size(); pos += 1 << 16)
+    {
+      stream.feed(t_begin + pos, std::min<size_t>(1 << 16, text.size() - pos),
+        [&matches](uint64_t) { ++matches; });
+    }
+  });
+
+  const al::simd_substring simd(
+    pattern.data(), pattern.data() + pattern.size()
+  );
+  run("simd find_all", [&]() {
+    simd.find_all(t_begin, t_end, count);
+  });
+
+  util::thread_pool pool;
+  run("boyer-moore parallel", [&]() {
+    matches = al::parallel_find_all(bm, t_begin, text.size(), pool).size();
+  });
+}
+
+inline void multi_pattern_search(
+  const std::string& text,
+  size_t num_patterns,
+  std::ostream& out
+)
+{
+  // words of the text, so every pattern occurs
+  std::vector<std::string> patterns;
+  for(size_t pos = 0; patterns.size() < num_patterns; )
+  {
+    const size_t space = text.find_first_of(" \n", pos);
+    if( space - pos >= 4 )
+      patterns.push_back(text.substr(pos, space - pos));
+    pos = space + 1;
+  }
+
+  const char * t_begin = text.data();
+  const char * t_end = t_begin + text.size();
+  size_t matches = 0;
+
+  const auto print = [&](const char * variant, double seconds) {
+    out << "multi-pattern," << num_patterns << "," << variant << ","
+        << matches << "," << (double(text.size()) / (1 << 20)) / seconds
+        << std::endl;
+  };
+
+  std::vector<al::boyer_moore_substring<const char *>> searchers;
+  for(const auto& pattern : patterns)
+    searchers.emplace_back(pattern.data(), pattern.data() + pattern.size());
+
+  print("boyer-moore per pattern", best_of(1, [&]() {
+    matches = 0;
+    for(const auto& bm : searchers)
+      bm.find_all(t_begin, t_end, [&matches](const char *) { ++matches; });
+  }));
+
+  const al::aho_corasick ac(patterns);
+  print("aho-corasick", best_of(3, [&]() {
+    matches = 0;
+    ac.find_all(t_begin, t_end,
+      [&matches](const char *, size_t) { ++matches; });
+  }));
+}
+
+inline void wide_search_for_pattern(
+  const std::string& text,
+  const std::string& pattern,
+  std::ostream& out
+)
+{
+  // the same characters, shifted into the CJK block
+  const auto widen = [](const std::string& narrow) {
+    std::u32string wide;
+    wide.reserve(narrow.size());
+    for(auto c : narrow)
+      wide.push_back(static_cast<char32_t>(0x4e00 + c));
+    return wide;
+  };
+  const std::u32string wide_text = widen(text);
+  const std::u32string wide_pattern = widen(pattern);
+
+  size_t matches = 0;
+  const auto print = [&](const char * variant, double seconds) {
+    out << "wide-search," << pattern.size() << "," << variant << ","
+        << matches << "," << (double(text.size()) / 1e6) / seconds
+        << std::endl;
+  };
+
+  const char * t_begin = text.data();
+  const al::boyer_moore_substring<const char *> narrow_bm(
+    pattern.data(), pattern.data() + pattern.size()
+  );
+  print("char", best_of(3, [&]() {
+    matches = 0;
+    narrow_bm.find_all(t_begin, t_begin + text.size(),
+      [&matches](const char *) { ++matches; });
+  }));
+
+  const char32_t * w_begin = wide_text.data();
+  const char32_t * w_end = w_begin + wide_text.size();
+  const auto count = [&matches](const char32_t *) { ++matches; };
+
+  const al::boyer_moore_substring<const char32_t *> flat_bm(
+    wide_pattern.data(), wide_pattern.data() + wide_pattern.size()
+  );
+  print("char32_t flat table", best_of(3, [&]() {
+    matches = 0;
+    flat_bm.find_all(w_begin, w_end, count);
+  }));
+
+  const al::boyer_moore_substring<
+    const char32_t *,
+    std::ptrdiff_t,
+    char32_t,
+    al::bm::dynamic_skip_table<char32_t, std::ptrdiff_t>
+  > dynamic_bm(
+    wide_pattern.data(), wide_pattern.data() + wide_pattern.size()
+  );
+  print("char32_t dynamic table", best_of(3, [&]() {
+    matches = 0;
+    dynamic_bm.find_all(w_begin, w_end, count);
+  }));
+}
+
+inline void string_search(std::ostream& out)
+{
+  const std::string text = random_text(64 << 20);
+
+  const size_t pattern_counts[] = { 10, 100, 1000 };
+  for(auto count : pattern_counts)
+    multi_pattern_search(text.substr(0, 4 << 20), count, out);
+
+  // taken from the text, so every pattern occurs at least once
+  const size_t lengths[] = { 2, 3, 4, 8, 16, 32 };
+  for(auto length : lengths)
+    string_search_for_pattern(text, text.substr(text.size() / 2, length), out);
+
+  const std::string wide_sample = text.substr(0, 16 << 20);
+  for(auto length : lengths)
+  {
+    wide_search_for_pattern(
+      wide_sample, wide_sample.substr(wide_sample.size() / 2, length), out
+    );
+  }
+}
+
+}
+
+#endif // BENCHMARK_STRING_SEARCH_H
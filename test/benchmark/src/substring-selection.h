@@ -0,0 +1,121 @@
+#ifndef BENCHMARK_SUBSTRING_SELECTION_H
+#define BENCHMARK_SUBSTRING_SELECTION_H
+
+/*
+ * Runtime of the substring searchers on test/src/data/sample-text.h (the
+ * GPL), by pattern length, for the choice of al::substring_searcher:
+ *
+ * - one-off: construct the searcher and find the first occurrence of a
+ *   pattern in the sample text (setup dominates)
+ * - find-all: all occurrences in 64 concatenated copies of the sample text
+ *   with a searcher constructed once
+ * - periodic: all occurrences of aaa...a in 1 MiB of a, the worst case of
+ *   every searcher but al::two_way_substring
+ *
+ * CSV rows: substring-selection,mode,pattern_length,variant,nanoseconds
+ *
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "al/boyer-moore-substring.h"
+#include "al/horspool-substring.h"
+#include "al/simd-substring.h"
+#include "al/substring-search.h"
+#include "al/sunday-substring.h"
+#include "al/two-way-substring.h"
+
+#include "../../src/data/sample-text.h"
+#include "timer.h"
+
+namespace bench {
+
+template<typename searcher_type>
+void substring_selection_variant(
+  const char * variant,
+  const std::string& pattern,
+  const std::string& text,
+  const std::string& periodic_text,
+  std::ostream& out
+)
+{
+  const char * p_begin = pattern.data();
+  const char * p_end = p_begin + pattern.size();
+  const char * sample_end = data::sample_text + std::strlen(data::sample_text);
+
+  // the occurrence is in the last quarter of the sample text
+  // the offsets are stored in a volatile, so none of the repeated
+  // searches can be dropped
+  const int repeat = 1000;
+  volatile std::ptrdiff_t offset = 0;
+  const double one_off = best_of(5, [&]() {
+    for(int i = 0; i < repeat; ++i)
+    {
+      const searcher_type searcher(p_begin, p_end);
+      offset = searcher.strstr(data::sample_text, sample_end) -
+        data::sample_text;
+    }
+  }) / repeat;
+
+  const searcher_type searcher(p_begin, p_end);
+  size_t matches = 0;
+  const double find_all = best_of(5, [&]() {
+    searcher.find_all(text.data(), text.data() + text.size(),
+      [&matches](const char *) { ++matches; });
+  });
+  do_not_optimize(matches);
+
+  const std::string periodic_pattern(pattern.size(), 'a');
+  const searcher_type periodic_searcher(
+    periodic_pattern.data(), periodic_pattern.data() + periodic_pattern.size()
+  );
+  const double periodic = best_of(3, [&]() {
+    periodic_searcher.find_all(
+      periodic_text.data(), periodic_text.data() + periodic_text.size(),
+      [&matches](const char *) { ++matches; });
+  });
+  do_not_optimize(matches);
+
+  out << "substring-selection,one-off," << pattern.size() << "," << variant
+      << "," << one_off * 1e9 << std::endl;
+  out << "substring-selection,find-all," << pattern.size() << "," << variant
+      << "," << find_all * 1e9 << std::endl;
+  out << "substring-selection,periodic," << pattern.size() << "," << variant
+      << "," << periodic * 1e9 << std::endl;
+}
+
+inline void substring_selection(std::ostream& out)
+{
+  const std::string sample(data::sample_text);
+  std::string text;
+  for(int i = 0; i < 64; ++i)
+    text += sample;
+  const std::string periodic_text(1 << 20, 'a');
+
+  const size_t lengths[] = { 2, 3, 4, 6, 8, 12, 16, 24, 32 };
+  for(auto length : lengths)
+  {
+    const std::string pattern = sample.substr(sample.size() * 3 / 4, length);
+
+    substring_selection_variant<al::boyer_moore_substring<const char *>>(
+      "boyer-moore", pattern, text, periodic_text, out);
+    substring_selection_variant<al::horspool_substring<const char *>>(
+      "horspool", pattern, text, periodic_text, out);
+    substring_selection_variant<al::sunday_substring<const char *>>(
+      "sunday", pattern, text, periodic_text, out);
+    substring_selection_variant<al::two_way_substring<const char *>>(
+      "two-way", pattern, text, periodic_text, out);
+    substring_selection_variant<al::simd_substring>(
+      "simd", pattern, text, periodic_text, out);
+    substring_selection_variant<al::substring_searcher>(
+      "substring_searcher", pattern, text, periodic_text, out);
+  }
+}
+
+}
+
+#endif // BENCHMARK_SUBSTRING_SELECTION_H
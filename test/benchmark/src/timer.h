@@ -0,0 +1,44 @@
+#ifndef BENCHMARK_TIMER_H
+#define BENCHMARK_TIMER_H
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace bench {
+
+// seconds of the fastest of trials runs of func; the minimum is least
+// disturbed by interrupts and context switches
+template<typename function>
+double best_of(int trials, function func)
+{
+  typedef std::chrono::steady_clock clock;
+
+  double best = std::numeric_limits<double>::max();
+  for(int i = 0; i < trials; ++i)
+  {
+    const clock::time_point begin = clock::now();
+    func();
+    const clock::time_point end = clock::now();
+
+    best = std::min(
+      best,
+      std::chrono::duration<double>(end - begin).count()
+    );
+  }
+
+  return best;
+}
+
+// keep the compiler from removing a computation whose result is unused:
+// the empty asm may read val and any memory, so val must be computed and
+// stored before it
+template<typename value_type>
+void do_not_optimize(const value_type& val)
+{
+  asm volatile("" : : "g"(&val) : "memory");
+}
+
+}
+
+#endif // BENCHMARK_TIMER_H
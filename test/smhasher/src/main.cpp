@@ -1,4 +1,5 @@
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include "al/murmur.h"
@@ -6,6 +7,8 @@
 #include "KeysetTest.h"
 #include "MurmurHash3.h"
 
+#include "speed-test.h"
+
 void smhasher_murmur_32(const void * data, int num_bytes, uint32_t seed, void * out)
 {
   const uint32_t hash = 
@@ -56,8 +59,30 @@ HashInfo g_hashes[] =
       "al::murmur_128" }
 };
 
+void print_usage(const char * name)
+{
+  std::cout << "Usage: " << name << " [--speed]" << "\n"
+            << "  without arguments: run the quality tests" << "\n"
+            << "  --speed: run the speed tests, print CSV to stdout" << std::endl;
+}
+
 int main(int argc, char * argv[])
 {
+  if( argc > 2 || ( argc == 2 && std::strcmp(argv[1], "--speed") != 0 ) )
+  {
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if( argc == 2 )
+  {
+    speed::print_csv_header(std::cout);
+    for(size_t i = 0; i < sizeof(g_hashes) / sizeof(HashInfo); i++)
+      speed::print_csv(g_hashes[i].hash, g_hashes[i].name, std::cout);
+
+    return EXIT_SUCCESS;
+  }
+
   for(size_t i = 0; i < sizeof(g_hashes) / sizeof(HashInfo); i++)
   {
     HashInfo * info = &g_hashes[i];
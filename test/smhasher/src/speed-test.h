@@ -0,0 +1,152 @@
+#ifndef SMHASHER_SPEED_TEST_H
+#define SMHASHER_SPEED_TEST_H
+
+/*
+ * Speed tests for the hash functions in g_hashes, printed as CSV.
+ *
+ * Every row has the format
+ *   hash,test,bytes,value,unit
+ *
+ * - latency: cycles per hash, each hash's result is the next hash's seed
+ *   (the cpu cannot overlap two consecutive hashes)
+ * - throughput: cycles per hash, hashes are independent of each other
+ * - bulk: GB/s for a single hash over a buffer much larger than the caches
+ *
+ * Cycles are counted with smhasher's rdtsc(), which ticks at a constant rate
+ * on modern cpus. Disable frequency scaling for comparable numbers.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "Platform.h"
+#include "Types.h"
+
+namespace speed {
+
+// minimum over all trials; the minimum is least disturbed by interrupts
+// and context switches
+const int key_trials = 200;
+const int key_batch = 1000;
+const int bulk_trials = 5;
+
+inline std::vector<uint8_t> random_bytes(size_t num_bytes)
+{
+  std::vector<uint8_t> bytes(num_bytes);
+  for(auto& byte : bytes)
+    byte = static_cast<uint8_t>(std::rand());
+
+  return bytes;
+}
+
+inline double key_latency_cycles(pfHash hash, const std::vector<uint8_t>& key)
+{
+  const int key_len = static_cast<int>(key.size());
+  double best = std::numeric_limits<double>::max();
+  uint32_t out[4] = {0, 0, 0, 0};
+
+  for(int trial = 0; trial < key_trials; ++trial)
+  {
+    const uint64_t begin = rdtsc();
+    for(int i = 0; i < key_batch; ++i)
+      hash(key.data(), key_len, out[0], out);
+    const uint64_t end = rdtsc();
+
+    best = std::min(best, static_cast<double>(end - begin) / key_batch);
+  }
+
+  return best;
+}
+
+inline double key_throughput_cycles(
+  pfHash hash,
+  const std::vector<uint8_t>& key
+)
+{
+  const int key_len = static_cast<int>(key.size());
+  double best = std::numeric_limits<double>::max();
+  uint32_t out[4] = {0, 0, 0, 0};
+  volatile uint32_t sink = 0;
+
+  for(int trial = 0; trial < key_trials; ++trial)
+  {
+    uint32_t combined = 0;
+
+    const uint64_t begin = rdtsc();
+    for(int i = 0; i < key_batch; ++i)
+    {
+      hash(key.data(), key_len, static_cast<uint32_t>(i), out);
+      combined ^= out[0];
+    }
+    const uint64_t end = rdtsc();
+
+    sink = combined;
+    best = std::min(best, static_cast<double>(end - begin) / key_batch);
+  }
+
+  // keep the compiler from removing the hash calls
+  static_cast<void>(sink);
+
+  return best;
+}
+
+inline double bulk_gb_per_s(pfHash hash, const std::vector<uint8_t>& buffer)
+{
+  typedef std::chrono::steady_clock clock;
+
+  const int buffer_len = static_cast<int>(buffer.size());
+  double best = std::numeric_limits<double>::max();
+  uint32_t out[4] = {0, 0, 0, 0};
+
+  for(int trial = 0; trial < bulk_trials; ++trial)
+  {
+    const clock::time_point begin = clock::now();
+    hash(buffer.data(), buffer_len, 0, out);
+    const clock::time_point end = clock::now();
+
+    best = std::min(
+      best,
+      std::chrono::duration<double>(end - begin).count()
+    );
+  }
+
+  return static_cast<double>(buffer.size()) / best / 1e9;
+}
+
+inline void print_csv_header(std::ostream& out)
+{
+  out << "hash,test,bytes,value,unit" << "\n";
+}
+
+inline void print_csv(
+  pfHash hash,
+  const char * name,
+  std::ostream& out,
+  size_t max_key_bytes = 256,
+  size_t bulk_bytes = 256U << 20
+)
+{
+  for(size_t key_bytes = 1; key_bytes <= max_key_bytes; ++key_bytes)
+  {
+    const std::vector<uint8_t> key(random_bytes(key_bytes));
+
+    out << name << ",latency," << key_bytes << ","
+        << key_latency_cycles(hash, key) << ",cycles/hash" << "\n";
+    out << name << ",throughput," << key_bytes << ","
+        << key_throughput_cycles(hash, key) << ",cycles/hash" << "\n";
+  }
+
+  const std::vector<uint8_t> buffer(random_bytes(bulk_bytes));
+  out << name << ",bulk," << bulk_bytes << ","
+      << bulk_gb_per_s(hash, buffer) << ",GB/s" << std::endl;
+}
+
+}
+
+#endif // SMHASHER_SPEED_TEST_H
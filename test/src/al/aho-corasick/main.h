@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/aho-corasick.h"
+
+#include "support/helpers.h"
+
+namespace {
+
+std::vector<al::aho_corasick::match> naive_multi_find(
+  const std::vector<std::string>& patterns,
+  const std::string& text
+)
+{
+  std::vector<al::aho_corasick::match> matches;
+  for(size_t p = 0; p < patterns.size(); ++p)
+  {
+    if( patterns[p].empty() )
+      continue;
+
+    for(auto offset : support::find_all_offsets(patterns[p], text))
+    {
+      const al::aho_corasick::match m = { static_cast<size_t>(offset), p };
+      matches.push_back(m);
+    }
+  }
+
+  std::sort(matches.begin(), matches.end());
+  return matches;
+}
+
+TEST(AlAhoCorasickTest, TextbookExample)
+{
+  const std::vector<std::string> patterns = { "he", "she", "his", "hers" };
+  const al::aho_corasick ac(patterns);
+  const std::string text("ushers");
+
+  const std::vector<al::aho_corasick::match> expected = {
+    { 1, 1 }, { 2, 0 }, { 2, 3 }
+  };
+  EXPECT_EQ(expected, ac.find_all(text.data(), text.data() + text.size()));
+
+  // h, e, s, i, r and the class of all other bytes
+  EXPECT_EQ(6u, ac.get_num_classes());
+  EXPECT_EQ(10u, ac.get_num_states());
+}
+
+TEST(AlAhoCorasickTest, ReportsByEndLongestFirst)
+{
+  const std::vector<std::string> patterns = { "a", "aa", "aaa", "", "aa" };
+  const al::aho_corasick ac(patterns);
+  const std::string text("aaa");
+
+  std::vector<std::pair<size_t, size_t>> found;
+  ac.find_all(text.data(), text.data() + text.size(),
+    [&](const char * begin, size_t pattern) {
+      found.emplace_back(static_cast<size_t>(begin - text.data()), pattern);
+    }
+  );
+
+  const std::vector<std::pair<size_t, size_t>> expected = {
+    { 0, 0 },
+    { 0, 1 }, { 0, 4 }, { 1, 0 },
+    { 0, 2 }, { 1, 1 }, { 1, 4 }, { 2, 0 }
+  };
+  EXPECT_EQ(expected, found);
+}
+
+TEST(AlAhoCorasickTest, MatchesNaiveSearch)
+{
+  std::srand(13);
+  for(int round = 0; round < 50; ++round)
+  {
+    std::vector<std::string> patterns(1 + std::rand() % 30);
+    for(auto& pattern : patterns)
+      for(int i = std::rand() % 6; i > 0; --i)
+        pattern.push_back("abc\xff"[std::rand() % 4]);
+
+    std::string text;
+    for(int i = std::rand() % 500; i > 0; --i)
+      text.push_back("abcd\xff"[std::rand() % 5]);
+
+    const al::aho_corasick ac(patterns);
+    std::vector<al::aho_corasick::match> found =
+      ac.find_all(text.data(), text.data() + text.size());
+    std::sort(found.begin(), found.end());
+
+    EXPECT_EQ(naive_multi_find(patterns, text), found) << "round " << round;
+  }
+}
+
+TEST(AlAhoCorasickTest, NoPatterns)
+{
+  const al::aho_corasick ac(std::vector<std::string>{});
+  const std::string text("text");
+  EXPECT_TRUE(ac.find_all(text.data(), text.data() + text.size()).empty());
+  EXPECT_EQ(1u, ac.get_num_states());
+}
+
+}
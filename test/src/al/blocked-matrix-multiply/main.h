@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/blocked-matrix-multiply.h"
+
+namespace {
+
+namespace hlp {
+
+  template<typename value_type>
+  ds::square_matrix<value_type> random_matrix(size_t width)
+  {
+    ds::square_matrix<value_type> m(width);
+    for(size_t row = 0; row < width; ++row)
+      for(size_t col = 0; col < width; ++col)
+        m.set(row, col, static_cast<value_type>(std::rand() % 19 - 9));
+
+    return m;
+  }
+
+  template<typename value_type>
+  ds::square_matrix<value_type> naive_multiply(
+    const ds::square_matrix<value_type>& left,
+    const ds::square_matrix<value_type>& right
+  )
+  {
+    const size_t width = left.get_width();
+    ds::square_matrix<value_type> result(width);
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        value_type sum = 0;
+        for(size_t i = 0; i < width; ++i)
+          sum += left.get(row, i) * right.get(i, col);
+        result.set(row, col, sum);
+      }
+    }
+
+    return result;
+  }
+
+} // namespace hlp
+
+template<typename T>
+class AlBlockedMatrixMultiplyTest : public ::testing::Test
+{};
+typedef ::testing::Types<int, long, float, double> blocked_value_types;
+TYPED_TEST_CASE(AlBlockedMatrixMultiplyTest, blocked_value_types);
+
+TYPED_TEST(AlBlockedMatrixMultiplyTest, MatchesNaiveMultiply)
+{
+  // widths around the tile and block edges
+  const size_t widths[] = { 1, 2, 3, 4, 7, 8, 9, 31, 64, 65, 100, 257 };
+
+  for(auto width : widths)
+  {
+    auto left = hlp::random_matrix<TypeParam>(width);
+    auto right = hlp::random_matrix<TypeParam>(width);
+
+    EXPECT_EQ(
+      hlp::naive_multiply(left, right),
+      al::blocked_matrix_multiply(left, right)
+    ) << "width " << width;
+  }
+}
+
+TEST(AlBlockedMatrixMultiplyTest, ThrowsOnSizeDiff)
+{
+  ds::square_matrix<int> m1(2);
+  ds::square_matrix<int> m2(1);
+
+  EXPECT_THROW(al::blocked_matrix_multiply(m1, m2), std::out_of_range);
+}
+
+
+}
+
@@ -1,7 +1,16 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "al/boyer-moore-substring.h"
+#include "al/bm/static-skip-table.h"
 
 #include "data/sample-text.h"
 
@@ -50,6 +59,32 @@ namespace hlp {
     >
   >;
 
+  // boyer_moore_substring with forced skip table type compact
+  template<typename iter>
+  using bm_compact_table_type =
+  al::boyer_moore_substring<
+    iter,
+    it_diff_t<iter>,
+    it_val_t<iter>,
+    al::bm::compact_skip_table<
+      it_val_t<iter>,
+      it_diff_t<iter>
+    >
+  >;
+
+  // boyer_moore_substring with forced skip table type flat
+  template<typename iter>
+  using bm_flat_table_type =
+  al::boyer_moore_substring<
+    iter,
+    it_diff_t<iter>,
+    it_val_t<iter>,
+    al::bm::flat_skip_table<
+      it_val_t<iter>,
+      it_diff_t<iter>
+    >
+  >;
+
   // boyer_moore_substring with forced skip table type dynamic
   template<typename iter>
   using bm_dynamic_table_type = 
@@ -67,22 +102,28 @@ namespace hlp {
 
 // test skip table selection
 template<typename T>
-class AlBoyerMooreStaticTableTest : public ::testing::Test
+class AlBoyerMooreCompactTableTest : public ::testing::Test
 {};
-typedef ::testing::Types<const char *, std::string::iterator> types_for_static_table;
-TYPED_TEST_CASE(AlBoyerMooreStaticTableTest, types_for_static_table);
+typedef ::testing::Types<const char *, std::string::iterator> types_for_compact_table;
+TYPED_TEST_CASE(AlBoyerMooreCompactTableTest, types_for_compact_table);
 
-TYPED_TEST(AlBoyerMooreStaticTableTest, UsesStaticTable)
+TYPED_TEST(AlBoyerMooreCompactTableTest, UsesCompactTable)
 {
-  bool uses_static_table = std::is_same<
+  bool uses_compact_table = std::is_same<
     // compare the type with automatic skip table selection
     al::boyer_moore_substring<TypeParam>,
-    // to the type with forced static skip table
-    hlp::bm_static_table_type<TypeParam>
+    // to the type with forced compact skip table
+    hlp::bm_compact_table_type<TypeParam>
   >::value;
   // if types are the same, the correct std::enable_if branch was chosen in 
   // boyer_moore_substring's template parameters
-  EXPECT_TRUE(uses_static_table);
+  EXPECT_TRUE(uses_compact_table);
+
+  bool uses_static_table = std::is_same<
+    al::boyer_moore_substring<TypeParam>,
+    hlp::bm_static_table_type<TypeParam>
+  >::value;
+  EXPECT_FALSE(uses_static_table);
 
   bool uses_dynamic_table = std::is_same<
     al::boyer_moore_substring<TypeParam>,
@@ -92,34 +133,45 @@ TYPED_TEST(AlBoyerMooreStaticTableTest, UsesStaticTable)
 }
 
 template<typename T>
-class AlBoyerMooreDynamicTableTest : public ::testing::Test
+class AlBoyerMooreFlatTableTest : public ::testing::Test
 {};
-typedef ::testing::Types<uint16_t *, uint32_t *, uint64_t *> types_for_dynamic_table;
-TYPED_TEST_CASE(AlBoyerMooreDynamicTableTest, types_for_dynamic_table);
+typedef ::testing::Types<
+  uint16_t *, uint32_t *, uint64_t *, const wchar_t *, std::u32string::iterator
+> types_for_flat_table;
+TYPED_TEST_CASE(AlBoyerMooreFlatTableTest, types_for_flat_table);
 
-TYPED_TEST(AlBoyerMooreDynamicTableTest, UsesDynamicTable)
+TYPED_TEST(AlBoyerMooreFlatTableTest, UsesFlatTable)
 {
+  bool uses_flat_table = std::is_same<
+    al::boyer_moore_substring<TypeParam>,
+    hlp::bm_flat_table_type<TypeParam>
+  >::value;
+  EXPECT_TRUE(uses_flat_table);
+
   bool uses_dynamic_table = std::is_same<
     al::boyer_moore_substring<TypeParam>,
     hlp::bm_dynamic_table_type<TypeParam>
   >::value;
-  EXPECT_TRUE(uses_dynamic_table);
+  EXPECT_FALSE(uses_dynamic_table);
 
-  bool uses_static_table = std::is_same<
+  bool uses_compact_table = std::is_same<
     al::boyer_moore_substring<TypeParam>,
-    hlp::bm_static_table_type<TypeParam>
+    hlp::bm_compact_table_type<TypeParam>
   >::value;
-  EXPECT_FALSE(uses_static_table);
+  EXPECT_FALSE(uses_compact_table);
 }
 
 // test the substring algorithm
-// run each test with the static skip table and the dynamic skip table
+// run each test with the static, dynamic, compact and flat skip tables
 template<typename T>
 class AlBoyerMooreSubstringTest : public ::testing::Test
 {};
 typedef ::testing::Types<
   al::bm::static_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>>,
-  al::bm::dynamic_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>>
+  al::bm::dynamic_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>>,
+  al::bm::compact_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>>,
+  al::bm::compact_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>, uint16_t>,
+  al::bm::flat_skip_table<hlp::it_val_t<const char *>, hlp::it_diff_t<const char *>>
 > table_types;
 TYPED_TEST_CASE(AlBoyerMooreSubstringTest, table_types);
 
@@ -240,5 +292,352 @@ TYPED_TEST(AlBoyerMooreSubstringTest, BehavesLikeStdStringFind)
 }
 
 
+TYPED_TEST(AlBoyerMooreSubstringTest, SuffixShiftKeepsPartialMatches)
+{
+  // after matching "bab" at 0, the pattern must not be shifted past 2
+  auto iter = hlp::bm_cc_strstr<TypeParam>("abab", "bbabab");
+  EXPECT_EQ(std::string("abab"), iter);
+}
+
+TYPED_TEST(AlBoyerMooreSubstringTest, NonAsciiCharacters)
+{
+  // negative chars must not index outside of the skip table
+  auto iter = hlp::bm_cc_strstr<TypeParam>("\xa4x", "\xc3\xa4\xc3\xa4x");
+  EXPECT_EQ(std::string("\xa4x"), iter);
+}
+
+TYPED_TEST(AlBoyerMooreSubstringTest, FindAllBehavesLikeStdSearch)
+{
+  std::srand(7);
+  for(int round = 0; round < 200; ++round)
+  {
+    std::string corpus, pattern;
+    for(int i = std::rand() % 200; i > 0; --i)
+      corpus.push_back(static_cast<char>('a' + std::rand() % 3));
+    for(int i = 1 + std::rand() % 6; i > 0; --i)
+      pattern.push_back(static_cast<char>('a' + std::rand() % 3));
+
+    const char * c_begin = corpus.data();
+    const char * c_end = c_begin + corpus.size();
+
+    std::vector<const char *> expected;
+    for(const char * it = c_begin;
+        (it = std::search(it, c_end, pattern.begin(), pattern.end())) != c_end;
+        ++it)
+      expected.push_back(it);
+
+    const char * p_begin = pattern.data();
+    al::boyer_moore_substring<
+      const char *,
+      hlp::it_diff_t<const char *>,
+      hlp::it_val_t<const char *>,
+      TypeParam
+    > bm(p_begin, p_begin + pattern.size());
+
+    EXPECT_EQ(expected, bm.find_all(c_begin, c_end))
+      << "pattern " << pattern << " corpus " << corpus;
+
+    size_t calls = 0;
+    bm.find_all(c_begin, c_end, [&](const char * match) {
+      ASSERT_LT(calls, expected.size());
+      EXPECT_EQ(expected[calls++], match);
+    });
+    EXPECT_EQ(expected.size(), calls);
+  }
+}
+
+TYPED_TEST(AlBoyerMooreSubstringTest, FindAllOverlappingAndEmpty)
+{
+  const char * pattern = "aa";
+  const char * corpus = "aaaa";
+  al::boyer_moore_substring<
+    const char *,
+    hlp::it_diff_t<const char *>,
+    hlp::it_val_t<const char *>,
+    TypeParam
+  > bm(pattern, pattern + 2);
+
+  const std::vector<const char *> expected = {
+    corpus, corpus + 1, corpus + 2
+  };
+  EXPECT_EQ(expected, bm.find_all(corpus, corpus + 4));
+  EXPECT_TRUE(bm.find_all(corpus, corpus + 1).empty());
+
+  al::boyer_moore_substring<
+    const char *,
+    hlp::it_diff_t<const char *>,
+    hlp::it_val_t<const char *>,
+    TypeParam
+  > empty(pattern, pattern);
+  EXPECT_TRUE(empty.find_all(corpus, corpus + 4).empty());
+}
+
+TYPED_TEST(AlBoyerMooreSubstringTest, CaseInsensitive)
+{
+  typedef al::boyer_moore_substring<
+    const char *,
+    hlp::it_diff_t<const char *>,
+    hlp::it_val_t<const char *>,
+    TypeParam,
+    al::bm::ascii_case_fold
+  > icase_bm;
+
+  const char * pattern = "PaTtErN";
+  const char * corpus = "a pattern, a PATTERN and a Pattern@Z[";
+  icase_bm bm(pattern, pattern + strlen(pattern));
+
+  const std::vector<const char *> expected = {
+    corpus + 2, corpus + 13, corpus + 27
+  };
+  EXPECT_EQ(expected, bm.find_all(corpus, corpus + strlen(corpus)));
+
+  // the pattern is kept as given, only the search folds it
+  EXPECT_EQ(
+    std::vector<char>(pattern, pattern + strlen(pattern)),
+    bm.get_pattern()
+  );
+
+  // '@' and '[' are next to 'A' and 'Z', they must not fold to '`' and '{'
+  const char * brackets = "`z{";
+  icase_bm bm_brackets(brackets, brackets + 3);
+  EXPECT_EQ(corpus + strlen(corpus),
+    bm_brackets.strstr(corpus, corpus + strlen(corpus)));
+  const char * lower = "@z[";
+  icase_bm bm_lower(lower, lower + 3);
+  EXPECT_EQ(corpus + strlen(corpus) - 3,
+    bm_lower.strstr(corpus, corpus + strlen(corpus)));
+
+  const auto equal_icase = [](char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) ==
+      std::tolower(static_cast<unsigned char>(b));
+  };
+
+  for(int test = 0; test < 200; ++test)
+  {
+    std::string random_corpus;
+    for(int i = std::rand() % 64; i > 0; --i)
+      random_corpus.push_back("abAB"[std::rand() % 4]);
+
+    std::string random_pattern;
+    for(int i = 1 + std::rand() % 6; i > 0; --i)
+      random_pattern.push_back("abAB"[std::rand() % 4]);
+
+    const char * c_begin = random_corpus.data();
+    const char * c_end = c_begin + random_corpus.size();
+
+    std::vector<const char *> expected_random;
+    for(const char * it = c_begin;
+        (it = std::search(it, c_end, random_pattern.begin(),
+          random_pattern.end(), equal_icase)) != c_end;
+        ++it)
+      expected_random.push_back(it);
+
+    icase_bm bm_random(
+      random_pattern.data(), random_pattern.data() + random_pattern.size()
+    );
+    EXPECT_EQ(expected_random, bm_random.find_all(c_begin, c_end))
+      << "pattern " << random_pattern << " corpus " << random_corpus;
+  }
+}
+
+TYPED_TEST(AlBoyerMooreSubstringTest, ByteClasses)
+{
+  // every digit matches every other digit
+  al::bm::byte_fold digits;
+  for(char c = '1'; c <= '9'; ++c)
+    digits.map(static_cast<unsigned char>(c), '0');
+
+  const char * pattern = "v0.0";
+  const char * corpus = "version v1.x, v2.17";
+  al::boyer_moore_substring<
+    const char *,
+    hlp::it_diff_t<const char *>,
+    hlp::it_val_t<const char *>,
+    TypeParam,
+    al::bm::byte_fold
+  > bm(pattern, pattern + strlen(pattern), digits);
+
+  const std::vector<const char *> expected = { corpus + 14 };
+  EXPECT_EQ(expected, bm.find_all(corpus, corpus + strlen(corpus)));
+}
+
+TEST(AlBmByteFoldTest, MapMergesClasses)
+{
+  // a chain of maps, each onto a byte that was mapped before
+  al::bm::byte_fold fold;
+  fold.map('a', 'b');
+  fold.map('b', 'c');
+  fold.map('x', 'y');
+  fold.map('c', 'x');
+
+  const char members[] = { 'a', 'b', 'c', 'x', 'y' };
+  for(auto l : members)
+    for(auto r : members)
+      EXPECT_EQ(fold(l), fold(r)) << l << " " << r;
+
+  EXPECT_NE(fold('a'), fold('z'));
+  EXPECT_EQ('z', fold('z'));
+}
+
+TEST(AlBoyerMooreWideTest, FlatAndDynamicTablesAgree)
+{
+  typedef std::u32string::const_iterator iter;
+  typedef al::boyer_moore_substring<
+    iter,
+    hlp::it_diff_t<iter>,
+    char32_t,
+    al::bm::dynamic_skip_table<char32_t, hlp::it_diff_t<iter>>
+  > dynamic_bm;
+
+  // code points of several scripts, some 64 apart (same hash bucket
+  // for a naive modulo)
+  const char32_t alphabet[] = {
+    U'a', U'b', U'\u00e4', U'\u0444', U'\u0484', U'\u4e2d', U'\u6587',
+    U'\U0001f600', U'\U0001f640'
+  };
+
+  std::srand(29);
+  for(int round = 0; round < 200; ++round)
+  {
+    std::u32string text, pattern;
+    for(int i = std::rand() % 200; i > 0; --i)
+      text.push_back(alphabet[std::rand() % 9]);
+    for(int i = 1 + std::rand() % 40; i > 0; --i)
+      pattern.push_back(alphabet[std::rand() % (round % 2 ? 3 : 9)]);
+
+    const al::boyer_moore_substring<iter> flat(pattern.begin(), pattern.end());
+    const dynamic_bm dynamic(pattern.begin(), pattern.end());
+
+    std::vector<iter> expected;
+    for(iter it = text.begin();
+        (it = std::search(it, text.cend(), pattern.begin(), pattern.end()))
+          != text.end();
+        ++it)
+      expected.push_back(it);
+
+    EXPECT_EQ(expected, flat.find_all(text.cbegin(), text.cend()));
+    EXPECT_EQ(expected, dynamic.find_all(text.cbegin(), text.cend()));
+  }
+}
+
+TEST(AlBoyerMooreWideTest, FlatTableGrowsWithPattern)
+{
+  al::bm::flat_skip_table<uint32_t, long> table(1000, -1);
+  for(uint32_t key = 0; key < 1000; ++key)
+    table.set(key * 4096, static_cast<long>(key));
+
+  for(uint32_t key = 0; key < 1000; ++key)
+    EXPECT_EQ(static_cast<long>(key), table.get(key * 4096));
+
+  table.set(0, 7);
+  EXPECT_EQ(7, table.get(0));
+  EXPECT_EQ(-1, table.get(1));
+  EXPECT_EQ(-1, table.get(4095));
+}
+
+TEST(AlBoyerMoorePatternTest, OwnsPattern)
+{
+  typedef al::boyer_moore_substring<std::string::const_iterator> bm_type;
+
+  std::string pattern("needle");
+  const bm_type bm(pattern.cbegin(), pattern.cend());
+  pattern = "xxxxxx";
+
+  const std::string text("haystack with a needle");
+  EXPECT_EQ(text.cbegin() + 16, bm.strstr(text.cbegin(), text.cend()));
+
+  // copies, moves and assignments search alike
+  std::vector<bm_type> cache;
+  cache.push_back(bm);
+  cache.emplace_back(text.cbegin(), text.cbegin() + 3);
+  cache[1] = cache[0];
+  const bm_type moved(std::move(cache[0]));
+
+  EXPECT_EQ(text.cbegin() + 16, moved.strstr(text.cbegin(), text.cend()));
+  EXPECT_EQ(text.cbegin() + 16, cache[1].strstr(text.cbegin(), text.cend()));
+}
+
+TEST(AlBoyerMoorePatternTest, SaveAndLoad)
+{
+  typedef al::boyer_moore_substring<const char *> bm_type;
+
+  const std::string text(data::sample_text);
+  const char * t_begin = text.data();
+  const char * t_end = t_begin + text.size();
+
+  const char * patterns[] = { "", "a", "Program", "GNU General Public" };
+  for(auto pattern : patterns)
+  {
+    const bm_type bm(pattern, pattern + strlen(pattern));
+
+    std::stringstream stream;
+    bm.save(stream);
+    const bm_type loaded = bm_type::load(stream);
+
+    EXPECT_EQ(bm.get_pattern(), loaded.get_pattern());
+    EXPECT_EQ(bm.get_pattern_length(), loaded.get_pattern_length());
+    EXPECT_EQ(bm.find_all(t_begin, t_end), loaded.find_all(t_begin, t_end))
+      << pattern;
+  }
+
+  // the fold is given to load
+  typedef al::boyer_moore_substring<
+    const char *,
+    hlp::it_diff_t<const char *>,
+    char,
+    al::bm::default_skip_table<char, hlp::it_diff_t<const char *>>::type,
+    al::bm::ascii_case_fold
+  > icase_bm_type;
+
+  const char * upper = "PROGRAM";
+  const icase_bm_type icase(upper, upper + 7);
+  std::stringstream icase_stream;
+  icase.save(icase_stream);
+  const icase_bm_type icase_loaded = icase_bm_type::load(icase_stream);
+
+  const char * lower = "program";
+  const size_t lower_matches = bm_type(lower, lower + 7)
+    .find_all(t_begin, t_end).size();
+  const std::vector<const char *> icase_matches =
+    icase_loaded.find_all(t_begin, t_end);
+  EXPECT_GT(icase_matches.size(), lower_matches);
+  EXPECT_TRUE(icase_matches == icase.find_all(t_begin, t_end));
+}
+
+TEST(AlBoyerMoorePatternTest, LoadRejectsInvalidStreams)
+{
+  typedef al::boyer_moore_substring<const char *> bm_type;
+  typedef al::boyer_moore_substring<const char32_t *> wide_bm_type;
+
+  const char * pattern = "pattern";
+  std::stringstream saved;
+  bm_type(pattern, pattern + 7).save(saved);
+  const std::string bytes = saved.str();
+
+  std::stringstream empty;
+  EXPECT_THROW(bm_type::load(empty), std::runtime_error);
+
+  std::stringstream garbage("garbage, not a pattern at all");
+  EXPECT_THROW(bm_type::load(garbage), std::runtime_error);
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  EXPECT_THROW(bm_type::load(truncated), std::runtime_error);
+
+  // saved with char, loaded as char32_t
+  std::stringstream wide(bytes);
+  EXPECT_THROW(wide_bm_type::load(wide), std::runtime_error);
+
+  // the length claims much more than there is
+  std::string huge(bytes);
+  const uint64_t length = uint64_t(1) << 40;
+  huge.replace(12, sizeof(length),
+    reinterpret_cast<const char *>(&length), sizeof(length));
+  std::stringstream huge_stream(huge);
+  EXPECT_THROW(bm_type::load(huge_stream), std::runtime_error);
+
+  std::stringstream intact(bytes);
+  EXPECT_EQ(7, bm_type::load(intact).get_pattern_length());
+}
+
 }
 
@@ -0,0 +1,85 @@
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/mm/elementwise.h"
+
+namespace {
+
+template<typename T>
+class AlElementwiseTest : public ::testing::Test
+{};
+typedef ::testing::Types<int, long, float, double, short> elementwise_value_types;
+TYPED_TEST_CASE(AlElementwiseTest, elementwise_value_types);
+
+namespace hlp {
+
+  template<typename value_type>
+  std::vector<value_type> random_vector(size_t num)
+  {
+    std::vector<value_type> v(num);
+    for(auto& val : v)
+      val = static_cast<value_type>(std::rand() % 19 - 9);
+
+    return v;
+  }
+
+} // namespace hlp
+
+// lengths around the vector widths, to cover the scalar tails
+const size_t elementwise_lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1001 };
+
+TYPED_TEST(AlElementwiseTest, AddSubtractScaleCopy)
+{
+  for(auto num : elementwise_lengths)
+  {
+    const auto left = hlp::random_vector<TypeParam>(num);
+    const auto right = hlp::random_vector<TypeParam>(num);
+    const TypeParam factor = 3;
+
+    std::vector<TypeParam> sum(num), difference(num), scaled(num), copy(num);
+    al::mm::elementwise::add(left.data(), right.data(), sum.data(), num);
+    al::mm::elementwise::subtract(
+      left.data(), right.data(), difference.data(), num
+    );
+    al::mm::elementwise::scale(left.data(), factor, scaled.data(), num);
+    al::mm::elementwise::copy(left.data(), copy.data(), num);
+
+    for(size_t i = 0; i < num; ++i)
+    {
+      EXPECT_EQ(static_cast<TypeParam>(left[i] + right[i]), sum[i]);
+      EXPECT_EQ(static_cast<TypeParam>(left[i] - right[i]), difference[i]);
+      EXPECT_EQ(static_cast<TypeParam>(left[i] * factor), scaled[i]);
+      EXPECT_EQ(left[i], copy[i]);
+    }
+  }
+}
+
+TYPED_TEST(AlElementwiseTest, OutputMayAliasOperands)
+{
+  for(auto num : elementwise_lengths)
+  {
+    const auto left = hlp::random_vector<TypeParam>(num);
+    const auto right = hlp::random_vector<TypeParam>(num);
+
+    auto in_place = left;
+    al::mm::elementwise::add(
+      in_place.data(), right.data(), in_place.data(), num
+    );
+    al::mm::elementwise::subtract(
+      in_place.data(), in_place.data(), in_place.data(), num
+    );
+    al::mm::elementwise::add(
+      in_place.data(), left.data(), in_place.data(), num
+    );
+    al::mm::elementwise::scale(
+      in_place.data(), TypeParam(2), in_place.data(), num
+    );
+    al::mm::elementwise::copy(in_place.data(), in_place.data(), num);
+
+    for(size_t i = 0; i < num; ++i)
+      EXPECT_EQ(static_cast<TypeParam>(left[i] * 2), in_place[i]);
+  }
+}
+
+}
@@ -0,0 +1,91 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/matrix.h"
+#include "al/matrix-chain-multiply.h"
+
+namespace {
+
+ds::matrix<long long> counting_matrix(size_t rows, size_t cols, long long seed)
+{
+  ds::matrix<long long> m(rows, cols);
+  for(size_t r = 0; r < rows; ++r)
+    for(size_t c = 0; c < cols; ++c)
+      m.set(r, c, static_cast<long long>((r * 7 + c * 3) % 5) - seed);
+
+  return m;
+}
+
+TEST(AlMatrixChainMultiplyTest, OrderOfTextbookExample)
+{
+  // Cormen et al., figure 15.5: ((A1 (A2 A3)) ((A4 A5) A6)), 15125
+  const std::vector<size_t> dims = { 30, 35, 15, 5, 10, 20, 25 };
+  const al::matrix_chain_plan plan = al::matrix_chain_order(dims);
+
+  EXPECT_EQ(15125u, plan.cost);
+  EXPECT_EQ(2u, plan.split[0 * 6 + 5]);
+  EXPECT_EQ(0u, plan.split[0 * 6 + 2]);
+  EXPECT_EQ(4u, plan.split[3 * 6 + 5]);
+
+  EXPECT_EQ(0u, al::matrix_chain_order({ 3, 4 }).cost);
+  EXPECT_THROW(al::matrix_chain_order({ 3 }), std::out_of_range);
+}
+
+TEST(AlMatrixChainMultiplyTest, MatchesLeftToRight)
+{
+  const size_t dims[] = { 10, 100, 5, 50, 1, 30, 7 };
+  std::vector<ds::matrix<long long>> chain;
+  for(size_t i = 0; i + 1 < sizeof(dims) / sizeof(dims[0]); ++i)
+    chain.push_back(
+      counting_matrix(dims[i], dims[i + 1], static_cast<long long>(i % 3))
+    );
+
+  ds::matrix<long long> expected(chain[0]);
+  for(size_t i = 1; i < chain.size(); ++i)
+    expected = expected * chain[i];
+
+  EXPECT_EQ(expected, al::matrix_chain_multiply(chain));
+
+  const std::vector<ds::matrix<long long>> single(1, chain[2]);
+  EXPECT_EQ(chain[2], al::matrix_chain_multiply(single));
+}
+
+TEST(AlMatrixChainMultiplyTest, SquareProductsAndLayouts)
+{
+  // square products of width 40 and 100 take the Winograd recursion, the
+  // column-major matrix the blocked kernel
+  const size_t dims[] = { 40, 40, 100, 100, 100, 40 };
+  std::vector<ds::matrix<long long>> chain;
+  for(size_t i = 0; i + 1 < sizeof(dims) / sizeof(dims[0]); ++i)
+    chain.push_back(
+      counting_matrix(dims[i], dims[i + 1], static_cast<long long>(i % 3))
+    );
+
+  ds::matrix<long long> column_major(
+    100, 100, ds::matrix_layout::column_major
+  );
+  for(size_t r = 0; r < 100; ++r)
+    for(size_t c = 0; c < 100; ++c)
+      column_major.set(r, c, chain[3].get(r, c));
+  chain[3] = column_major;
+
+  ds::matrix<long long> expected(chain[0]);
+  for(size_t i = 1; i < chain.size(); ++i)
+    expected = expected * chain[i];
+
+  EXPECT_EQ(expected, al::matrix_chain_multiply(chain, 8));
+  EXPECT_EQ(expected, al::matrix_chain_multiply(chain));
+}
+
+TEST(AlMatrixChainMultiplyTest, Throws)
+{
+  std::vector<ds::matrix<int>> chain;
+  EXPECT_THROW(al::matrix_chain_multiply(chain), std::out_of_range);
+
+  chain.push_back(ds::matrix<int>(2, 3));
+  chain.push_back(ds::matrix<int>(4, 2));
+  EXPECT_THROW(al::matrix_chain_multiply(chain), std::out_of_range);
+}
+
+}
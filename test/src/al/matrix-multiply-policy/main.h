@@ -0,0 +1,106 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/blocked-matrix-multiply.h"
+#include "al/matrix-multiply-policy.h"
+
+namespace {
+
+TEST(AlMatrixMultiplyPolicyTest, DepthLimitedCrossover)
+{
+  EXPECT_EQ(1024u, al::mm::depth_limited_crossover(1024, 0, 64));
+  EXPECT_EQ(512u, al::mm::depth_limited_crossover(1024, 1, 64));
+  EXPECT_EQ(128u, al::mm::depth_limited_crossover(1024, 3, 64));
+  EXPECT_EQ(64u, al::mm::depth_limited_crossover(1024, 10, 64));
+  EXPECT_EQ(513u, al::mm::depth_limited_crossover(1025, 1, 64));
+  EXPECT_EQ(128u, al::mm::depth_limited_crossover(100, 5, 128));
+}
+
+TEST(AlMatrixMultiplyPolicyTest, AllPoliciesMultiply)
+{
+  const al::multiply_policy policies[] = {
+    al::strassen_policy(),
+    al::strassen_policy(1),
+    al::blocked_policy(),
+    al::kahan_policy()
+  };
+
+  const size_t widths[] = { 1, 7, 64, 300 };
+  for(auto width : widths)
+  {
+    // small integers, so every algorithm is exact
+    ds::square_matrix<double> m1(width);
+    ds::square_matrix<double> m2(width);
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        m1.set(row, col, static_cast<double>((row * 7 + col * 3) % 11) - 5);
+        m2.set(row, col, static_cast<double>((row * 5 + col) % 13) - 6);
+      }
+    }
+
+    const ds::square_matrix<double> expected(
+      al::blocked_matrix_multiply(m1, m2)
+    );
+    for(const auto& policy : policies)
+    {
+      EXPECT_EQ(expected, al::matrix_multiply(m1, m2, policy))
+        << "width " << width;
+      EXPECT_EQ(expected, m1.multiply(m2, policy)) << "width " << width;
+    }
+  }
+}
+
+TEST(AlMatrixMultiplyPolicyTest, StrassenWithoutLevelsIsBlocked)
+{
+  ds::square_matrix<double> m(256);
+  for(size_t row = 0; row < 256; ++row)
+    for(size_t col = 0; col < 256; ++col)
+      m.set(row, col, std::sin(static_cast<double>(row * 256 + col)));
+
+  // bitwise identical, the same kernel computes the same sums
+  EXPECT_EQ(
+    al::blocked_matrix_multiply(m, m),
+    al::matrix_multiply(m, m, al::strassen_policy(0))
+  );
+}
+
+TEST(AlMatrixMultiplyPolicyTest, KahanKeepsSmallSummands)
+{
+  // every element of the product is 1 + 255 * 1e-16; a plain sum loses
+  // each 1e-16 (less than half an ulp of 1), a compensated sum doesn't
+  const size_t width = 256;
+  ds::square_matrix<double> left(width);
+  ds::square_matrix<double> right(width);
+  for(size_t row = 0; row < width; ++row)
+  {
+    for(size_t col = 0; col < width; ++col)
+    {
+      left.set(row, col, col == 0 ? 1.0 : 1e-16);
+      right.set(row, col, 1.0);
+    }
+  }
+
+  const double exact = 1.0 + 255e-16;
+  const auto blocked = al::matrix_multiply(left, right, al::blocked_policy());
+  const auto kahan = al::matrix_multiply(left, right, al::kahan_policy());
+
+  EXPECT_EQ(1.0, blocked.get(3, 5));
+  EXPECT_NEAR(exact, kahan.get(3, 5), 1e-16);
+  EXPECT_NEAR(exact, kahan.get(width - 1, width - 1), 1e-16);
+}
+
+TEST(AlMatrixMultiplyPolicyTest, ThrowsOnSizeDiff)
+{
+  ds::square_matrix<double> m1(2);
+  ds::square_matrix<double> m2(3);
+
+  EXPECT_THROW(
+    al::matrix_multiply(m1, m2, al::kahan_policy()), std::out_of_range
+  );
+}
+
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/blocked-matrix-multiply.h"
+#include "al/matrix-power.h"
+
+namespace {
+
+template<typename value_type>
+ds::square_matrix<value_type> naive_power(
+  const ds::square_matrix<value_type>& base,
+  unsigned long long exponent
+)
+{
+  ds::square_matrix<value_type> result(base.get_width());
+  for(size_t i = 0; i < base.get_width(); ++i)
+    result.set(i, i, value_type(1));
+
+  for(unsigned long long i = 0; i < exponent; ++i)
+    result = al::blocked_matrix_multiply(result, base);
+
+  return result;
+}
+
+TEST(AlMatrixPowerTest, MatchesRepeatedMultiplication)
+{
+  const size_t widths[] = { 1, 3, 16, 70, 128 };
+  const unsigned long long exponents[] = { 0, 1, 2, 3, 7, 8, 13 };
+
+  for(auto width : widths)
+  {
+    // entries of the powers stay small: every row has one 1, one -1
+    ds::square_matrix<long long> m(width);
+    for(size_t row = 0; row < width; ++row)
+    {
+      m.set(row, (row * 3 + 1) % width, 1);
+      m.set(row, (row * 5 + 2) % width, -1);
+    }
+
+    for(auto exponent : exponents)
+    {
+      EXPECT_EQ(naive_power(m, exponent), al::matrix_power(m, exponent, 16))
+        << "width " << width << " exponent " << exponent;
+    }
+  }
+}
+
+TEST(AlMatrixPowerTest, Fibonacci)
+{
+  ds::square_matrix<unsigned long long> m(2);
+  m.set(0, 0, 1);
+  m.set(0, 1, 1);
+  m.set(1, 0, 1);
+
+  const ds::square_matrix<unsigned long long> p(m.pow(90));
+  EXPECT_EQ(2880067194370816120ull, p.get(0, 1));
+  EXPECT_EQ(4660046610375530309ull, p.get(0, 0));
+}
+
+TEST(AlMatrixPowerTest, StochasticMatrixConverges)
+{
+  // a transition matrix with the stationary distribution (2/3, 1/3)
+  ds::square_matrix<double> m(2);
+  m.set(0, 0, 0.9);
+  m.set(0, 1, 0.1);
+  m.set(1, 0, 0.2);
+  m.set(1, 1, 0.8);
+
+  const ds::square_matrix<double> p(m.pow(1000));
+  for(size_t row = 0; row < 2; ++row)
+  {
+    EXPECT_NEAR(2.0 / 3, p.get(row, 0), 1e-12);
+    EXPECT_NEAR(1.0 / 3, p.get(row, 1), 1e-12);
+  }
+}
+
+}
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/modular-matrix-multiply.h"
+
+namespace {
+
+template<typename value_type>
+ds::square_matrix<value_type> naive_modular_product(
+  const ds::square_matrix<value_type>& l,
+  const ds::square_matrix<value_type>& r,
+  uint32_t modulus
+)
+{
+  const size_t width = l.get_width();
+  std::vector<uint64_t> a(width * width), b(width * width);
+  for(size_t i = 0; i < width * width; ++i)
+  {
+    a[i] = al::mm::modular_reduce(l.raw_data()[i], modulus);
+    b[i] = al::mm::modular_reduce(r.raw_data()[i], modulus);
+  }
+
+  ds::square_matrix<value_type> result(width);
+  for(size_t i = 0; i < width; ++i)
+    for(size_t j = 0; j < width; ++j)
+    {
+      uint64_t sum = 0;
+      for(size_t k = 0; k < width; ++k)
+        sum = (sum + a[i * width + k] * b[k * width + j] % modulus) % modulus;
+      result.set(i, j, static_cast<value_type>(sum));
+    }
+
+  return result;
+}
+
+TEST(AlModularMatrixMultiplyTest, DelayBeforeReduction)
+{
+  EXPECT_EQ(UINT64_MAX, al::mm::modular_delay(1));
+  EXPECT_EQ(UINT64_MAX - 1, al::mm::modular_delay(2));
+  EXPECT_EQ(1u, al::mm::modular_delay(UINT32_MAX));
+  EXPECT_LT(uint64_t(1) << 32, al::mm::modular_delay(65521));
+}
+
+TEST(AlModularMatrixMultiplyTest, MatchesNaive)
+{
+  const uint32_t moduli[] = { 1, 2, 7, 65521, 1000000007u, 4294967291u };
+  const size_t widths[] = { 1, 3, 17, 40, 520 };
+
+  for(auto width : widths)
+  {
+    ds::square_matrix<int64_t> l(width), r(width);
+    for(size_t row = 0; row < width; ++row)
+      for(size_t col = 0; col < width; ++col)
+      {
+        l.set(row, col, int64_t((row * 2654435761u + col * 40503u) % 4294967291u));
+        r.set(row, col, int64_t((row * 97u + col * 2246822519u) % 4294967291u));
+      }
+
+    for(auto modulus : moduli)
+    {
+      // the naive product is slow beyond a single column panel
+      if( width > 100 && modulus != 4294967291u )
+        continue;
+
+      EXPECT_EQ(naive_modular_product(l, r, modulus),
+        al::modular_matrix_multiply(l, r, modulus))
+        << "width " << width << " modulus " << modulus;
+    }
+  }
+}
+
+TEST(AlModularMatrixMultiplyTest, NegativeValuesAreResidues)
+{
+  ds::square_matrix<int> l(2), r(2);
+  l.set(0, 0, -1);
+  l.set(1, 1, -8);
+  r.set(0, 0, 1);
+  r.set(1, 1, 1);
+
+  const ds::square_matrix<int> p(al::modular_matrix_multiply(l, r, 7));
+  EXPECT_EQ(6, p.get(0, 0));
+  EXPECT_EQ(6, p.get(1, 1));
+  EXPECT_EQ(0, p.get(0, 1));
+}
+
+TEST(AlModularMatrixMultiplyTest, Throws)
+{
+  ds::square_matrix<int> m2(2), m3(3);
+  EXPECT_THROW(al::modular_matrix_multiply(m2, m3, 7), std::out_of_range);
+  EXPECT_THROW(al::modular_matrix_multiply(m2, m2, 0), std::out_of_range);
+
+  // residues up to 199 don't fit in int8_t
+  ds::square_matrix<int8_t> narrow(2);
+  EXPECT_THROW(al::modular_matrix_multiply(narrow, narrow, 200),
+    std::out_of_range);
+  EXPECT_NO_THROW(al::modular_matrix_multiply(narrow, narrow, 128));
+}
+
+}
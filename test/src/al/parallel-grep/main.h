@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/boyer-moore-substring.h"
+#include "al/parallel-grep.h"
+#include "util/thread-pool.h"
+
+#include "support/helpers.h"
+
+namespace {
+
+typedef al::boyer_moore_substring<const char *> grep_searcher;
+
+TEST(AlParallelGrepTest, MatchesSequentialSearchForAnyChunkSize)
+{
+  std::srand(5);
+  std::string text;
+  for(int i = 0; i < 5000; ++i)
+    text.push_back("ab\xc3\xa4\n"[std::rand() % 5]);
+
+  util::thread_pool pool(3);
+  const std::string patterns[] = { "a", "ab", "aba", "b\xc3\xa4", "abab\nab" };
+  const size_t chunk_sizes[] = { 1, 2, 7, 64, 1000, 10000 };
+
+  for(const auto& pattern : patterns)
+  {
+    const grep_searcher bm(pattern.data(), pattern.data() + pattern.size());
+    const std::vector<uint64_t> expected = support::find_all_offsets(pattern, text);
+
+    for(auto chunk_size : chunk_sizes)
+    {
+      EXPECT_EQ(expected,
+        al::parallel_find_all(bm, text.data(), text.size(), pool, chunk_size))
+        << "pattern " << pattern << " chunk size " << chunk_size;
+    }
+  }
+}
+
+TEST(AlParallelGrepTest, SearchesFile)
+{
+  const std::string path = support::temp_file_path();
+  std::string text;
+  for(int i = 0; i < 20000; ++i)
+    text += "request " + std::to_string(i) + (i % 97 ? " ok\n" : " failed\n");
+
+  {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out << text;
+  }
+
+  util::thread_pool pool(2);
+  const std::string pattern(" failed");
+  const grep_searcher bm(pattern.data(), pattern.data() + pattern.size());
+
+  const std::vector<uint64_t> offsets =
+    al::parallel_grep_file(bm, path, pool, 4096);
+  EXPECT_EQ(support::find_all_offsets(pattern, text), offsets);
+  EXPECT_EQ(207u, offsets.size());
+
+  std::remove(path.c_str());
+
+  EXPECT_THROW(al::parallel_grep_file(bm, path, pool), std::runtime_error);
+}
+
+TEST(AlParallelGrepTest, EmptyPatternAndText)
+{
+  util::thread_pool pool(2);
+  const char * pattern = "x";
+  const grep_searcher bm(pattern, pattern + 1);
+  const grep_searcher empty(pattern, pattern);
+
+  EXPECT_TRUE(al::parallel_find_all(bm, pattern, 0, pool).empty());
+  EXPECT_TRUE(al::parallel_find_all(empty, pattern, 1, pool).empty());
+}
+
+}
@@ -0,0 +1,93 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/matrix.h"
+#include "ds/sparse-matrix.h"
+#include "al/parallel-sparse-matrix-multiply.h"
+#include "util/thread-pool.h"
+
+namespace {
+
+namespace hlp {
+
+  // non-zeros clustered in the first rows, to exercise load balancing
+  inline ds::sparse_matrix<long> clustered_sparse(
+    size_t rows,
+    size_t cols,
+    ds::matrix_layout layout
+  )
+  {
+    std::vector<ds::sparse_entry<long>> entries;
+    for(size_t row = 0; row < rows; ++row)
+    {
+      const size_t step = row < rows / 8 ? 1 : 13;
+      for(size_t col = row % step; col < cols; col += step)
+        entries.push_back({ row, col, static_cast<long>((row * col) % 7) - 3 });
+    }
+
+    return ds::sparse_matrix<long>(rows, cols, entries, layout);
+  }
+
+} // namespace hlp
+
+TEST(AlParallelSparseMultiplyTest, BalancedLineRanges)
+{
+  // 6 lines, almost all non-zeros in line 1
+  const std::vector<size_t> offsets = { 0, 1, 91, 93, 96, 99, 100 };
+
+  const std::vector<size_t> bounds = al::mm::balanced_line_ranges(offsets, 4);
+  EXPECT_EQ(0u, bounds.front());
+  EXPECT_EQ(6u, bounds.back());
+  for(size_t i = 1; i < bounds.size(); ++i)
+    EXPECT_LT(bounds[i - 1], bounds[i]);
+
+  EXPECT_EQ(
+    std::vector<size_t>({ 0, 3 }),
+    al::mm::balanced_line_ranges({ 0, 0, 0, 0 }, 8)
+  );
+}
+
+TEST(AlParallelSparseMultiplyTest, MatchesSequentialMultiply)
+{
+  util::thread_pool pool(3);
+
+  for(auto layout :
+    { ds::matrix_layout::row_major, ds::matrix_layout::column_major })
+  {
+    const auto left = hlp::clustered_sparse(200, 150, layout);
+    const auto right = hlp::clustered_sparse(150, 90,
+      ds::matrix_layout::row_major
+    );
+
+    std::vector<long> x(150);
+    for(size_t i = 0; i < x.size(); ++i)
+      x[i] = static_cast<long>(i % 11) - 5;
+
+    EXPECT_EQ(
+      left * x, al::parallel_sparse_matrix_vector_multiply(left, x, pool)
+    );
+    EXPECT_EQ(
+      left * right, al::parallel_sparse_matrix_multiply(left, right, pool)
+    );
+    EXPECT_EQ(
+      (left * right).to_matrix(), left.to_matrix() * right.to_matrix()
+    );
+  }
+}
+
+TEST(AlParallelSparseMultiplyTest, ThrowsOnSizeDiff)
+{
+  util::thread_pool pool(2);
+  const ds::sparse_matrix<int> m(3, 4);
+
+  EXPECT_THROW(
+    al::parallel_sparse_matrix_vector_multiply(m, std::vector<int>(3), pool),
+    std::out_of_range
+  );
+  EXPECT_THROW(
+    al::parallel_sparse_matrix_multiply(m, m, pool), std::out_of_range
+  );
+}
+
+}
@@ -0,0 +1,81 @@
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/strassen-matrix-multiply.h"
+#include "al/parallel-strassen-matrix-multiply.h"
+#include "util/thread-pool.h"
+
+namespace {
+
+TEST(AlParallelStrassenTest, MatchesSequentialStrassen)
+{
+  ds::square_matrix<int> m1(256);
+  ds::square_matrix<int> m2(256);
+
+  for(size_t row = 0; row < m1.get_width(); ++row)
+  {
+    for(size_t col = 0; col < m1.get_width(); ++col)
+    {
+      m1.set(row, col, static_cast<int>((row * 3 + col * 7) % 17) - 8);
+      m2.set(row, col, static_cast<int>((row * 11 + col) % 5) - 2);
+    }
+  }
+
+  const ds::square_matrix<int> expected(
+    al::strassen_matrix_multiply(m1, m2, 16)
+  );
+
+  util::thread_pool pool(4);
+  for(size_t depth = 0; depth <= 4; ++depth)
+  {
+    EXPECT_EQ(
+      expected,
+      al::parallel_strassen_matrix_multiply(m1, m2, pool, depth, 16)
+    ) << "parallel depth " << depth;
+  }
+}
+
+TEST(AlParallelStrassenTest, SingleThreadPool)
+{
+  ds::square_matrix<double> m(128);
+  for(size_t row = 0; row < m.get_width(); ++row)
+    for(size_t col = 0; col < m.get_width(); ++col)
+      m.set(row, col, static_cast<double>((row + col) % 3));
+
+  util::thread_pool pool(1);
+  EXPECT_EQ(
+    al::strassen_matrix_multiply(m, m, 8),
+    al::parallel_strassen_matrix_multiply(m, m, pool, 3, 8)
+  );
+}
+
+TEST(AlParallelStrassenTest, MultipliesAnyWidth)
+{
+  ds::square_matrix<int> m(150);
+  for(size_t row = 0; row < m.get_width(); ++row)
+    for(size_t col = 0; col < m.get_width(); ++col)
+      m.set(row, col, static_cast<int>((row * 2 + col) % 7) - 3);
+
+  util::thread_pool pool(3);
+  EXPECT_EQ(
+    al::strassen_matrix_multiply(m, m, 16),
+    al::parallel_strassen_matrix_multiply(m, m, pool, 2, 16)
+  );
+}
+
+TEST(AlParallelStrassenTest, ThrowsOnSizeDiff)
+{
+  ds::square_matrix<int> m1(2);
+  ds::square_matrix<int> m2(1);
+
+  util::thread_pool pool(2);
+  EXPECT_THROW(
+    al::parallel_strassen_matrix_multiply(m1, m2, pool),
+    std::out_of_range
+  );
+}
+
+
+}
+
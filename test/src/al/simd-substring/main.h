@@ -0,0 +1,83 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/simd-substring.h"
+
+#include "support/helpers.h"
+
+namespace {
+
+TEST(AlSimdSubstringTest, FindAllBehavesLikeStdStringFind)
+{
+  std::srand(3);
+  for(int round = 0; round < 300; ++round)
+  {
+    std::string text, pattern;
+    for(int i = std::rand() % 400; i > 0; --i)
+      text.push_back("ab\xc3\n"[std::rand() % 4]);
+    for(int i = 1 + std::rand() % 40; i > 0; --i)
+      pattern.push_back("ab\xc3\n"[std::rand() % 4]);
+
+    // short patterns match often, long ones are taken from the text
+    if( pattern.size() > 6 && text.size() > pattern.size() )
+      pattern = text.substr(
+        static_cast<size_t>(std::rand()) % (text.size() - pattern.size()),
+        pattern.size()
+      );
+
+    const al::simd_substring simd(
+      pattern.data(), pattern.data() + pattern.size()
+    );
+    const char * t_begin = text.data();
+    const char * t_end = t_begin + text.size();
+    const std::vector<const char *> expected =
+      support::find_all_pointers(pattern, text);
+
+    EXPECT_EQ(expected, simd.find_all(t_begin, t_end))
+      << "pattern " << pattern << " text " << text;
+    EXPECT_EQ(expected.empty() ? t_end : expected.front(),
+      simd.strstr(t_begin, t_end));
+  }
+}
+
+TEST(AlSimdSubstringTest, MatchesAtBlockBoundariesAndEnd)
+{
+  const std::string pattern("needle");
+  const al::simd_substring simd(
+    pattern.data(), pattern.data() + pattern.size()
+  );
+
+  for(size_t pos = 0; pos < 100; ++pos)
+  {
+    std::string text(100 + pattern.size(), 'x');
+    text.replace(pos, pattern.size(), pattern);
+    text.resize(std::max(pos + pattern.size(), size_t(70)));
+
+    const std::vector<const char *> found =
+      simd.find_all(text.data(), text.data() + text.size());
+    ASSERT_EQ(1u, found.size()) << "position " << pos;
+    EXPECT_EQ(text.data() + pos, found[0]);
+  }
+}
+
+TEST(AlSimdSubstringTest, EmptyAndSingleByte)
+{
+  const char * text = "abcabc";
+  const char * text_end = text + 6;
+
+  const al::simd_substring empty(text, text);
+  EXPECT_EQ(text, empty.strstr(text, text_end));
+  EXPECT_TRUE(empty.find_all(text, text_end).empty());
+
+  const al::simd_substring single(text + 2, text + 3);
+  const std::vector<const char *> expected = { text + 2, text + 5 };
+  EXPECT_EQ(expected, single.find_all(text, text_end));
+  EXPECT_EQ(1, single.get_pattern_length());
+
+  const al::simd_substring longer(text, text_end);
+  EXPECT_EQ(text + 3, longer.strstr(text, text + 3));
+}
+
+}
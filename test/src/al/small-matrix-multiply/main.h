@@ -0,0 +1,177 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/small-matrix-multiply.h"
+
+namespace {
+
+namespace hlp {
+
+  template<typename value_type>
+  ds::square_matrix<value_type> sequence_matrix(size_t width, int start)
+  {
+    ds::square_matrix<value_type> m(width);
+    for(size_t row = 0; row < width; ++row)
+      for(size_t col = 0; col < width; ++col)
+        m.set(row, col, static_cast<value_type>(
+          (start + static_cast<int>(row * 5 + col * 3)) % 11 - 5
+        ));
+
+    return m;
+  }
+
+  template<typename value_type>
+  ds::square_matrix<value_type> classical_multiply(
+    const ds::square_matrix<value_type>& left,
+    const ds::square_matrix<value_type>& right
+  )
+  {
+    const size_t width = left.get_width();
+    ds::square_matrix<value_type> result(width);
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        value_type sum = 0;
+        for(size_t i = 0; i < width; ++i)
+          sum += left.get(row, i) * right.get(i, col);
+        result.set(row, col, sum);
+      }
+    }
+
+    return result;
+  }
+
+} // namespace hlp
+
+template<typename T>
+class AlSmallMatrixMultiplyTest : public ::testing::Test
+{};
+typedef ::testing::Types<int, long, float, double> small_value_types;
+TYPED_TEST_CASE(AlSmallMatrixMultiplyTest, small_value_types);
+
+TYPED_TEST(AlSmallMatrixMultiplyTest, MatchesClassicalMultiply)
+{
+  // every unrolled width, and beyond
+  for(size_t width = 1; width <= al::small_matrix_max_width + 3; ++width)
+  {
+    const auto left = hlp::sequence_matrix<TypeParam>(width, 1);
+    const auto right = hlp::sequence_matrix<TypeParam>(width, 4);
+    const auto expected = hlp::classical_multiply(left, right);
+
+    EXPECT_EQ(expected, al::small_matrix_multiply(left, right))
+      << "width " << width;
+    EXPECT_EQ(expected, left * right) << "width " << width;
+  }
+}
+
+TYPED_TEST(AlSmallMatrixMultiplyTest, MultipliesBatches)
+{
+  const size_t widths[] = { 3, 4, 8, 16, 20 };
+  const size_t count = 5;
+
+  for(auto width : widths)
+  {
+    const size_t size = width * width;
+    std::vector<ds::square_matrix<TypeParam>> left, right;
+    std::vector<TypeParam> packed_left, packed_right;
+    for(size_t i = 0; i < count; ++i)
+    {
+      left.push_back(
+        hlp::sequence_matrix<TypeParam>(width, static_cast<int>(i))
+      );
+      right.push_back(
+        hlp::sequence_matrix<TypeParam>(width, static_cast<int>(i * 7))
+      );
+      packed_left.insert(packed_left.end(),
+        left[i].raw_data(), left[i].raw_data() + size);
+      packed_right.insert(packed_right.end(),
+        right[i].raw_data(), right[i].raw_data() + size);
+    }
+
+    const auto products = al::batched_matrix_multiply(left, right);
+    ASSERT_EQ(count, products.size());
+
+    std::vector<TypeParam> packed_out(count * size);
+    al::mm::batched_multiply(
+      width, packed_left.data(), packed_right.data(), packed_out.data(), count
+    );
+
+    for(size_t i = 0; i < count; ++i)
+    {
+      const auto expected = hlp::classical_multiply(left[i], right[i]);
+      EXPECT_EQ(expected, products[i]);
+
+      for(size_t j = 0; j < size; ++j)
+        EXPECT_EQ(expected.raw_data()[j], packed_out[i * size + j]);
+    }
+  }
+}
+
+TEST(AlSmallMatrixMultiplyTest, BatchedIntoReusesOutput)
+{
+  std::vector<ds::square_matrix<float>> left, right;
+  for(int i = 0; i < 5; ++i)
+  {
+    left.push_back(hlp::sequence_matrix<float>(4, i));
+    right.push_back(hlp::sequence_matrix<float>(4, i * 3));
+  }
+
+  // too many matrices, of another width
+  std::vector<ds::square_matrix<float>> out(7, ds::square_matrix<float>(3));
+  al::batched_matrix_multiply(left, right, out);
+  ASSERT_EQ(left.size(), out.size());
+
+  std::vector<const float *> buffers;
+  for(size_t i = 0; i < out.size(); ++i)
+  {
+    EXPECT_EQ(hlp::classical_multiply(left[i], right[i]), out[i]);
+    buffers.push_back(out[i].raw_data());
+  }
+
+  // the same batch again writes into the same matrices
+  std::swap(left, right);
+  al::batched_matrix_multiply(left, right, out);
+  for(size_t i = 0; i < out.size(); ++i)
+  {
+    EXPECT_EQ(hlp::classical_multiply(left[i], right[i]), out[i]);
+    EXPECT_EQ(buffers[i], out[i].raw_data());
+  }
+
+  // falls back to the blocked kernel above small_matrix_max_width
+  const std::vector<ds::square_matrix<int>> large(
+    2, hlp::sequence_matrix<int>(al::small_matrix_max_width + 3, 1)
+  );
+  const auto products = al::batched_matrix_multiply(large, large);
+  ASSERT_EQ(2U, products.size());
+  EXPECT_EQ(hlp::classical_multiply(large[0], large[0]), products[1]);
+
+  std::vector<ds::square_matrix<float>> empty;
+  al::batched_matrix_multiply(empty, empty, out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(AlSmallMatrixMultiplyTest, ThrowsOnSizeDiff)
+{
+  ds::square_matrix<int> m1(2);
+  ds::square_matrix<int> m2(3);
+
+  EXPECT_THROW(al::small_matrix_multiply(m1, m2), std::out_of_range);
+  EXPECT_THROW(
+    al::batched_matrix_multiply(
+      std::vector<ds::square_matrix<int>>(2, m1),
+      std::vector<ds::square_matrix<int>>(1, m1)
+    ),
+    std::out_of_range
+  );
+
+  const std::vector<ds::square_matrix<int>> mixed = { m1, m2 };
+  EXPECT_THROW(
+    al::batched_matrix_multiply(mixed, mixed),
+    std::out_of_range
+  );
+}
+
+}
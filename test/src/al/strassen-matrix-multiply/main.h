@@ -1,8 +1,10 @@
 #include <stdexcept>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "ds/square-matrix.h"
 #include "al/strassen-matrix-multiply.h"
+#include "al/blocked-matrix-multiply.h"
 
 namespace {
 
@@ -27,6 +29,53 @@ TEST(AlStrassenTest, Multiplies)
   EXPECT_TRUE(result == m2);
 }
 
+TEST(AlStrassenTest, MatchesBlockedMultiplyBeyondCrossover)
+{
+  ds::square_matrix<int> m1(4 * al::strassen_crossover<int>::value);
+  ds::square_matrix<int> m2(4 * al::strassen_crossover<int>::value);
+
+  for(size_t row = 0; row < m1.get_width(); ++row)
+  {
+    for(size_t col = 0; col < m1.get_width(); ++col)
+    {
+      m1.set(row, col, static_cast<int>((row * 7 + col * 3) % 11) - 5);
+      m2.set(row, col, static_cast<int>((row * 5 + col) % 13) - 6);
+    }
+  }
+
+  EXPECT_EQ(
+    al::blocked_matrix_multiply(m1, m2),
+    al::strassen_matrix_multiply(m1, m2)
+  );
+}
+
+TEST(AlStrassenTest, AnyCrossoverWidthGivesSameResult)
+{
+  ds::square_matrix<double> m1(32);
+  ds::square_matrix<double> m2(32);
+
+  for(size_t row = 0; row < m1.get_width(); ++row)
+  {
+    for(size_t col = 0; col < m1.get_width(); ++col)
+    {
+      m1.set(row, col, static_cast<double>((row + col * 3) % 7) - 3.0);
+      m2.set(row, col, static_cast<double>((row * 5 + col) % 9) - 4.0);
+    }
+  }
+
+  const ds::square_matrix<double> expected(
+    al::blocked_matrix_multiply(m1, m2)
+  );
+
+  // small integers only, so there's no rounding error
+  const size_t crossover_widths[] = { 0, 1, 2, 4, 8, 16, 32 };
+  for(auto crossover : crossover_widths)
+  {
+    EXPECT_EQ(expected, al::strassen_matrix_multiply(m1, m2, crossover))
+      << "crossover width " << crossover;
+  }
+}
+
 TEST(AlStrassenTest, ThrowsOnSizeDiff)
 {
   ds::square_matrix<int> m1(2);
@@ -41,12 +90,112 @@ TEST(AlStrassenTest, ThrowsOnSizeDiff)
   EXPECT_THROW(al::strassen_matrix_multiply(m1, m2), std::out_of_range);
 }
 
-TEST(AlStrassenTest, ThrowsOnNotPowerOfTwo)
+TEST(AlStrassenTest, MultipliesAnyWidth)
+{
+  const size_t widths[] = { 3, 5, 31, 65, 100, 129, 200 };
+
+  for(auto width : widths)
+  {
+    ds::square_matrix<int> m1(width);
+    ds::square_matrix<int> m2(width);
+
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        m1.set(row, col, static_cast<int>((row * 7 + col * 3) % 11) - 5);
+        m2.set(row, col, static_cast<int>((row * 5 + col) % 13) - 6);
+      }
+    }
+
+    const ds::square_matrix<int> expected(al::blocked_matrix_multiply(m1, m2));
+    EXPECT_EQ(expected, al::strassen_matrix_multiply(m1, m2))
+      << "width " << width;
+    EXPECT_EQ(expected, al::strassen_matrix_multiply(m1, m2, 8))
+      << "width " << width;
+  }
+}
+
+TEST(AlStrassenTest, PadsToMultipleOfLeafWidth)
 {
-  ds::square_matrix<int> m1(5);
-  EXPECT_THROW(al::strassen_matrix_multiply(m1, m1), std::out_of_range);
+  EXPECT_EQ(1056, al::mm::strassen_padded_width(1025, 64));
+  EXPECT_EQ(1024, al::mm::strassen_padded_width(1024, 64));
+  EXPECT_EQ(64, al::mm::strassen_padded_width(64, 64));
+  EXPECT_EQ(13, al::mm::strassen_padded_width(13, 64));
+  EXPECT_EQ(132, al::mm::strassen_padded_width(129, 64));
+  EXPECT_EQ(8, al::mm::strassen_padded_width(5, 0));
+  EXPECT_EQ(8, al::mm::strassen_padded_width(5, 1));
 }
 
 
+TEST(AlStrassenTest, MortonLayoutRoundTrip)
+{
+  // 5 x 5 padded to 8 x 8 in tiles of 2 x 2
+  const size_t width = 5;
+  ds::square_matrix<int> m(width);
+  for(size_t row = 0; row < width; ++row)
+    for(size_t col = 0; col < width; ++col)
+      m.set(row, col, static_cast<int>(row * width + col) + 1);
+
+  std::vector<int> morton(64, -1);
+  al::mm::to_morton<int>(
+    al::mm::matrix_view<const int>(m.raw_data(), width, width),
+    morton.data(), 8, 2
+  );
+
+  // tile 1 is the top right tile of the top left quadrant,
+  // tile 4 the top left tile of the top right quadrant
+  EXPECT_EQ(3, morton[4]);
+  EXPECT_EQ(4, morton[5]);
+  EXPECT_EQ(8, morton[6]);
+  EXPECT_EQ(5, morton[16]);
+  EXPECT_EQ(0, morton[17]);
+  EXPECT_EQ(0, morton[63]);
+
+  ds::square_matrix<int> back(width);
+  al::mm::from_morton<int>(
+    morton.data(),
+    al::mm::matrix_view<int>(back.raw_data(), width, width),
+    8, 2
+  );
+  EXPECT_EQ(m, back);
+}
+
+TEST(AlStrassenTest, MortonMatchesBlockedMultiply)
+{
+  const size_t widths[] = { 1, 3, 64, 65, 100, 129, 256 };
+  const size_t crossovers[] = { 8, 64 };
+
+  for(auto width : widths)
+  {
+    ds::square_matrix<int> m1(width);
+    ds::square_matrix<int> m2(width);
+
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        m1.set(row, col, static_cast<int>((row * 7 + col * 3) % 11) - 5);
+        m2.set(row, col, static_cast<int>((row * 5 + col) % 13) - 6);
+      }
+    }
+
+    const ds::square_matrix<int> expected(al::blocked_matrix_multiply(m1, m2));
+    for(auto crossover : crossovers)
+    {
+      EXPECT_EQ(
+        expected, al::morton_strassen_matrix_multiply(m1, m2, crossover)
+      ) << "width " << width << " crossover " << crossover;
+    }
+  }
 }
 
+TEST(AlStrassenTest, MortonThrowsOnSizeDiff)
+{
+  ds::square_matrix<int> m1(2);
+  ds::square_matrix<int> m2(3);
+
+  EXPECT_THROW(al::morton_strassen_matrix_multiply(m1, m2), std::out_of_range);
+}
+
+}
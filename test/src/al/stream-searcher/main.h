@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/boyer-moore-substring.h"
+#include "al/stream-searcher.h"
+
+#include "support/helpers.h"
+
+namespace {
+
+typedef al::boyer_moore_substring<const char *> char_searcher;
+
+TEST(AlStreamSearcherTest, MatchesWholeInputForAnyChunking)
+{
+  std::srand(11);
+  for(int round = 0; round < 100; ++round)
+  {
+    std::string corpus, pattern;
+    for(int i = std::rand() % 300; i > 0; --i)
+      corpus.push_back(static_cast<char>('a' + std::rand() % 2));
+    for(int i = 1 + std::rand() % 8; i > 0; --i)
+      pattern.push_back(static_cast<char>('a' + std::rand() % 2));
+
+    const char_searcher bm(pattern.data(), pattern.data() + pattern.size());
+    const std::vector<uint64_t> expected = support::find_all_offsets(pattern, corpus);
+
+    for(size_t chunk = 1; chunk <= 11; chunk += 2)
+    {
+      al::stream_searcher<char_searcher> stream(bm);
+      std::vector<uint64_t> offsets;
+      for(size_t pos = 0; pos < corpus.size(); pos += chunk)
+      {
+        const size_t size = std::min(chunk, corpus.size() - pos);
+        stream.feed(corpus.data() + pos, size, [&](uint64_t offset) {
+          offsets.push_back(offset);
+        });
+      }
+
+      EXPECT_EQ(expected, offsets)
+        << "pattern " << pattern << " chunk " << chunk;
+      EXPECT_EQ(corpus.size(), stream.get_consumed());
+    }
+  }
+}
+
+TEST(AlStreamSearcherTest, SearchesIstream)
+{
+  std::string corpus;
+  for(int i = 0; i < 1000; ++i)
+    corpus += "lorem ipsum dolor sit amet ";
+  corpus += "needle";
+
+  const std::string pattern("ipsum dolor");
+  const char_searcher bm(pattern.data(), pattern.data() + pattern.size());
+
+  std::istringstream in(corpus);
+  std::vector<uint64_t> offsets;
+  const uint64_t read = al::stream_search(bm, in, [&](uint64_t offset) {
+    offsets.push_back(offset);
+  }, 100);
+
+  EXPECT_EQ(corpus.size(), read);
+  EXPECT_EQ(support::find_all_offsets(pattern, corpus), offsets);
+}
+
+}
@@ -0,0 +1,251 @@
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "al/horspool-substring.h"
+#include "al/substring-search.h"
+#include "al/sunday-substring.h"
+#include "al/two-way-substring.h"
+
+#include "data/sample-text.h"
+#include "support/helpers.h"
+
+namespace {
+
+// substring_searcher with a fixed algorithm
+template<al::substring_algorithm algo>
+struct fixed_searcher : al::substring_searcher
+{
+  fixed_searcher(const char * begin, const char * end)
+  : al::substring_searcher(begin, end, algo)
+  {
+  }
+};
+
+template<typename T>
+class AlSubstringSearchTest : public ::testing::Test
+{};
+typedef ::testing::Types<
+  al::horspool_substring<const char *>,
+  al::sunday_substring<const char *>,
+  al::two_way_substring<const char *>,
+  al::substring_searcher,
+  fixed_searcher<al::substring_algorithm::boyer_moore>,
+  fixed_searcher<al::substring_algorithm::horspool>,
+  fixed_searcher<al::substring_algorithm::sunday>,
+  fixed_searcher<al::substring_algorithm::simd>,
+  fixed_searcher<al::substring_algorithm::two_way>
+> substring_searcher_types;
+TYPED_TEST_CASE(AlSubstringSearchTest, substring_searcher_types);
+
+TYPED_TEST(AlSubstringSearchTest, FindAllBehavesLikeStdStringFind)
+{
+  std::srand(17);
+  for(int round = 0; round < 300; ++round)
+  {
+    std::string text, pattern;
+    for(int i = std::rand() % 300; i > 0; --i)
+      text.push_back("ab\xe4"[std::rand() % 3]);
+    for(int i = 1 + std::rand() % 7; i > 0; --i)
+      pattern.push_back("ab\xe4"[std::rand() % 3]);
+
+    const TypeParam searcher(pattern.data(), pattern.data() + pattern.size());
+    const char * t_begin = text.data();
+    const char * t_end = t_begin + text.size();
+    const std::vector<const char *> expected =
+      support::find_all_pointers(pattern, text);
+
+    EXPECT_EQ(expected, searcher.find_all(t_begin, t_end))
+      << "pattern " << pattern << " text " << text;
+    EXPECT_EQ(expected.empty() ? t_end : expected.front(),
+      searcher.strstr(t_begin, t_end));
+  }
+}
+
+TYPED_TEST(AlSubstringSearchTest, SampleText)
+{
+  const std::string text(data::sample_text);
+  const char * patterns[] = { "Program", "the", "License", "GNU GENERAL" };
+
+  for(auto pattern : patterns)
+  {
+    const TypeParam searcher(pattern, pattern + std::strlen(pattern));
+    EXPECT_EQ(support::find_all_pointers(pattern, text),
+      searcher.find_all(text.data(), text.data() + text.size()))
+      << pattern;
+  }
+}
+
+// longer than a uint8_t skip table entry can hold
+TYPED_TEST(AlSubstringSearchTest, LongPatterns)
+{
+  std::srand(23);
+  std::string text;
+  for(int i = 0; i < 4000; ++i)
+    text.push_back("abcdefgh"[std::rand() % (i % 1000 < 500 ? 2 : 8)]);
+
+  for(int round = 0; round < 20; ++round)
+  {
+    const size_t length = 250 + static_cast<size_t>(std::rand() % 500);
+    const size_t first = static_cast<size_t>(std::rand()) %
+      (text.size() - length);
+    const std::string pattern = text.substr(first, length);
+
+    const TypeParam searcher(pattern.data(), pattern.data() + pattern.size());
+    EXPECT_EQ(support::find_all_pointers(pattern, text),
+      searcher.find_all(text.data(), text.data() + text.size()))
+      << "length " << length << " first " << first;
+  }
+}
+
+TYPED_TEST(AlSubstringSearchTest, PeriodicPatterns)
+{
+  const std::string texts[] = {
+    std::string(200, 'a'),
+    std::string(100, 'a') + "b" + std::string(100, 'a'),
+    "abababababababababaabababababababab",
+    "abaabaabaabaababaabaabaaba"
+  };
+  const std::string patterns[] = {
+    "a", "aa", std::string(20, 'a'), std::string(20, 'a') + "b",
+    "b" + std::string(20, 'a'), "abab", "ababa", "abaaba", "aab", "baa"
+  };
+
+  for(const auto& text : texts)
+  {
+    for(const auto& pattern : patterns)
+    {
+      const TypeParam searcher(
+        pattern.data(), pattern.data() + pattern.size()
+      );
+      EXPECT_EQ(support::find_all_pointers(pattern, text),
+        searcher.find_all(text.data(), text.data() + text.size()))
+        << "pattern " << pattern << " text " << text;
+    }
+  }
+}
+
+TYPED_TEST(AlSubstringSearchTest, EmptyPatternAndShortText)
+{
+  const char * text = "abc";
+
+  const TypeParam empty(text, text);
+  EXPECT_EQ(text, empty.strstr(text, text + 3));
+  EXPECT_TRUE(empty.find_all(text, text + 3).empty());
+
+  const TypeParam whole(text, text + 3);
+  EXPECT_EQ(text + 2, whole.strstr(text, text + 2));
+  EXPECT_EQ(3, whole.get_pattern_length());
+}
+
+TEST(AlSubstringSearchTest, ChoosesAlgorithm)
+{
+  const std::string dna("ACGTTGCAACGTACGTAGCT");
+  EXPECT_EQ(al::substring_algorithm::boyer_moore,
+    al::choose_substring_algorithm(dna.data(), dna.data() + dna.size()));
+
+  const std::string word("Program");
+  const al::substring_algorithm expected =
+    al::simd_substring::is_vectorized() ?
+      al::substring_algorithm::simd : al::substring_algorithm::sunday;
+  EXPECT_EQ(expected,
+    al::choose_substring_algorithm(word.data(), word.data() + word.size()));
+
+  const std::string phrase("GNU General Public License");
+  const al::substring_searcher searcher(
+    phrase.data(), phrase.data() + phrase.size()
+  );
+  EXPECT_NE(al::substring_algorithm::boyer_moore, searcher.get_algorithm());
+}
+
+TEST(AlSubstringSearchTest, SearcherOwnsPattern)
+{
+  std::string pattern("needle");
+  al::substring_searcher searcher(
+    pattern.data(), pattern.data() + pattern.size(),
+    al::substring_algorithm::horspool
+  );
+  pattern = "xxxxxx";
+
+  const al::substring_searcher moved(std::move(searcher));
+  const std::string text("haystack with a needle");
+  EXPECT_EQ(text.data() + 16,
+    moved.strstr(text.data(), text.data() + text.size()));
+}
+
+// a char counting its comparisons
+struct counted_char
+{
+  char c;
+
+  static size_t comparisons;
+
+  bool operator==(const counted_char& other) const
+  {
+    ++comparisons;
+    return this->c == other.c;
+  }
+
+  bool operator<(const counted_char& other) const
+  {
+    ++comparisons;
+    return this->c < other.c;
+  }
+};
+
+size_t counted_char::comparisons = 0;
+
+std::vector<counted_char> counted(const std::string& str)
+{
+  std::vector<counted_char> chars;
+  for(auto c : str)
+    chars.push_back(counted_char{c});
+
+  return chars;
+}
+
+TEST(AlTwoWaySubstringTest, LinearComparisons)
+{
+  typedef std::vector<counted_char>::const_iterator iter;
+
+  const std::string texts[] = {
+    std::string(20000, 'a'),
+    std::string(10000, 'a') + std::string(10000, 'b'),
+    [] {
+      std::string t;
+      while( t.size() < 20000 )
+        t += std::string(999, 'a') + "b";
+      return t;
+    }()
+  };
+  const std::string patterns[] = {
+    std::string(1000, 'a'),
+    std::string(999, 'a') + "b",
+    "b" + std::string(999, 'a')
+  };
+
+  for(const auto& text_str : texts)
+  {
+    const std::vector<counted_char> text = counted(text_str);
+    for(const auto& pattern_str : patterns)
+    {
+      const std::vector<counted_char> pattern = counted(pattern_str);
+      const al::two_way_substring<iter> searcher(pattern.begin(), pattern.end());
+
+      counted_char::comparisons = 0;
+      const std::vector<iter> matches =
+        searcher.find_all(text.cbegin(), text.cend());
+
+      EXPECT_EQ(
+        support::find_all_offsets(pattern_str, text_str).size(),
+        matches.size()
+      );
+      EXPECT_LE(counted_char::comparisons, 2 * text.size());
+    }
+  }
+}
+
+}
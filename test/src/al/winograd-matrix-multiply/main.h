@@ -0,0 +1,124 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+#include "al/blocked-matrix-multiply.h"
+#include "al/winograd-matrix-multiply.h"
+
+namespace {
+
+template<typename T>
+class AlWinogradTest : public ::testing::Test
+{};
+typedef ::testing::Types<int, double> winograd_value_types;
+TYPED_TEST_CASE(AlWinogradTest, winograd_value_types);
+
+TYPED_TEST(AlWinogradTest, MatchesBlockedMultiply)
+{
+  const size_t widths[] = { 1, 3, 16, 64, 65, 100, 129, 256 };
+  const size_t crossovers[] = { 8, 64 };
+
+  for(auto width : widths)
+  {
+    ds::square_matrix<TypeParam> m1(width);
+    ds::square_matrix<TypeParam> m2(width);
+
+    for(size_t row = 0; row < width; ++row)
+    {
+      for(size_t col = 0; col < width; ++col)
+      {
+        m1.set(row, col, static_cast<TypeParam>((row * 7 + col * 3) % 11) - 5);
+        m2.set(row, col, static_cast<TypeParam>((row * 5 + col) % 13) - 6);
+      }
+    }
+
+    const ds::square_matrix<TypeParam> expected(
+      al::blocked_matrix_multiply(m1, m2)
+    );
+
+    for(auto crossover : crossovers)
+    {
+      EXPECT_EQ(expected, al::winograd_matrix_multiply(m1, m2, crossover))
+        << "width " << width << " crossover " << crossover;
+    }
+  }
+}
+
+TEST(AlWinogradTest, ReusesWorkspace)
+{
+  ds::square_matrix<int> m(128);
+  for(size_t row = 0; row < 128; ++row)
+    m.set(row, row, 2);
+
+  std::vector<int> workspace;
+  const ds::square_matrix<int> once(
+    al::winograd_matrix_multiply(m, m, workspace, 16)
+  );
+
+  // 2 * (64^2 + 32^2 + 16^2)
+  EXPECT_EQ(10752u, workspace.size());
+
+  const int * data = workspace.data();
+  EXPECT_EQ(once, al::winograd_matrix_multiply(m, m, workspace, 16));
+  EXPECT_EQ(data, workspace.data());
+
+  ds::square_matrix<int> expected(128);
+  for(size_t row = 0; row < 128; ++row)
+    expected.set(row, row, 4);
+  EXPECT_EQ(expected, once);
+}
+
+TEST(AlWinogradTest, PadsInsideWorkspace)
+{
+  // 100 is padded to 104 = 13 * 2^3
+  ds::square_matrix<int> m(100);
+  for(size_t row = 0; row < 100; ++row)
+  {
+    m.set(row, row, 2);
+    m.set(row, 99 - row, 1);
+  }
+  const ds::square_matrix<int> expected(al::blocked_matrix_multiply(m, m));
+
+  // stale values must not leak into the padding
+  std::vector<int> workspace(
+    al::mm::winograd_multiply_workspace_size(100, 16), 7
+  );
+  const int * data = workspace.data();
+
+  EXPECT_EQ(expected, al::winograd_matrix_multiply(m, m, workspace, 16));
+  EXPECT_EQ(expected, al::winograd_matrix_multiply(m, m, workspace, 16));
+  EXPECT_EQ(data, workspace.data());
+}
+
+TEST(AlWinogradTest, WorkspaceSize)
+{
+  EXPECT_EQ(0u, al::mm::winograd_workspace_size(64, 64));
+  EXPECT_EQ(0u, al::mm::winograd_workspace_size(65, 8));
+  EXPECT_EQ(2u * 64 * 64, al::mm::winograd_workspace_size(128, 64));
+  // stops at the odd width 33
+  EXPECT_EQ(
+    2u * (528 * 528 + 264 * 264 + 132 * 132 + 66 * 66 + 33 * 33),
+    al::mm::winograd_workspace_size(1056, 64)
+  );
+
+  EXPECT_EQ(
+    al::mm::winograd_workspace_size(128, 64),
+    al::mm::winograd_multiply_workspace_size(128, 64)
+  );
+  // the padded operands and product of width 104, then the temporaries
+  EXPECT_EQ(
+    3u * 104 * 104 + 2u * (52 * 52 + 26 * 26 + 13 * 13),
+    al::mm::winograd_multiply_workspace_size(100, 16)
+  );
+}
+
+TEST(AlWinogradTest, ThrowsOnSizeDiff)
+{
+  ds::square_matrix<int> m1(2);
+  ds::square_matrix<int> m2(3);
+
+  EXPECT_THROW(al::winograd_matrix_multiply(m1, m2), std::out_of_range);
+}
+
+}
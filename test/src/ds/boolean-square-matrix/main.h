@@ -0,0 +1,120 @@
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/square-matrix.h"
+
+namespace {
+
+typedef ds::square_matrix<bool> bool_matrix;
+
+bool_matrix random_bool_matrix(size_t width, int percent)
+{
+  bool_matrix m(width);
+  for(size_t row = 0; row < width; ++row)
+    for(size_t col = 0; col < width; ++col)
+      m.set(row, col, std::rand() % 100 < percent);
+
+  return m;
+}
+
+bool_matrix naive_bool_product(const bool_matrix& l, const bool_matrix& r)
+{
+  const size_t width = l.get_width();
+  bool_matrix result(width);
+  for(size_t i = 0; i < width; ++i)
+    for(size_t j = 0; j < width; ++j)
+      for(size_t k = 0; k < width; ++k)
+        if( l.get(i, k) && r.get(k, j) )
+        {
+          result.set(i, j, true);
+          break;
+        }
+
+  return result;
+}
+
+TEST(DsBooleanSquareMatrixTest, GetSetCount)
+{
+  bool_matrix m(70);
+  EXPECT_EQ(2u, m.get_words_per_row());
+  EXPECT_EQ(0u, m.count());
+
+  m.set(0, 0, true);
+  m.set(3, 64, true);
+  m.set(69, 69, true);
+  EXPECT_TRUE(m.get(3, 64));
+  EXPECT_FALSE(m.get(3, 63));
+  EXPECT_EQ(3u, m.count());
+
+  m.set(3, 64, false);
+  EXPECT_FALSE(m.get(3, 64));
+  EXPECT_EQ(2u, m.count());
+
+  EXPECT_THROW(m.get(70, 0), std::out_of_range);
+  EXPECT_THROW(m.set(0, 70, true), std::out_of_range);
+  EXPECT_THROW(bool_matrix(0), std::out_of_range);
+}
+
+TEST(DsBooleanSquareMatrixTest, ProductMatchesNaive)
+{
+  const size_t widths[] = { 1, 5, 8, 63, 64, 65, 130 };
+  const int densities[] = { 2, 20, 70 };
+
+  for(auto width : widths)
+  {
+    for(auto percent : densities)
+    {
+      const bool_matrix l(random_bool_matrix(width, percent));
+      const bool_matrix r(random_bool_matrix(width, percent));
+
+      EXPECT_EQ(naive_bool_product(l, r), l * r)
+        << "width " << width << " density " << percent;
+    }
+  }
+}
+
+TEST(DsBooleanSquareMatrixTest, TransitiveClosureOfPath)
+{
+  // edges i -> i + 1; reach = (I | A)^(2^k) covers the whole path
+  const size_t width = 100;
+  bool_matrix reach(width);
+  for(size_t i = 0; i < width; ++i)
+  {
+    reach.set(i, i, true);
+    if( i + 1 < width )
+      reach.set(i, i + 1, true);
+  }
+
+  for(size_t step = 1; step < width; step *= 2)
+    reach = reach * reach;
+
+  EXPECT_EQ(width * (width + 1) / 2, reach.count());
+  EXPECT_TRUE(reach.get(0, width - 1));
+  EXPECT_FALSE(reach.get(width - 1, 0));
+}
+
+TEST(DsBooleanSquareMatrixTest, DisjunctionAndEquality)
+{
+  bool_matrix a(3), b(3);
+  a.set(0, 1, true);
+  b.set(2, 2, true);
+
+  const bool_matrix c(a | b);
+  EXPECT_TRUE(c.get(0, 1));
+  EXPECT_TRUE(c.get(2, 2));
+  EXPECT_EQ(2u, c.count());
+  EXPECT_NE(a, c);
+  EXPECT_EQ(c, b | a);
+
+  std::ostringstream out;
+  a.print(out);
+  EXPECT_EQ("\n0\t1\t0\t\n0\t0\t0\t\n0\t0\t0\t\n", out.str());
+
+  EXPECT_THROW(a * bool_matrix(4), std::out_of_range);
+  EXPECT_THROW(a | bool_matrix(4), std::out_of_range);
+}
+
+}
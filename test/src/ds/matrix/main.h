@@ -0,0 +1,231 @@
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/matrix.h"
+
+namespace {
+
+namespace hlp {
+
+  template<typename value_type>
+  void fill_sequence(ds::matrix<value_type>& m, int start)
+  {
+    for(size_t row = 0; row < m.get_rows(); ++row)
+      for(size_t col = 0; col < m.get_cols(); ++col)
+        m.set(row, col, static_cast<value_type>(
+          start + static_cast<int>(row * m.get_cols() + col) % 17 - 8
+        ));
+  }
+
+  template<typename value_type>
+  ds::matrix<value_type> naive_multiply(
+    const ds::matrix<value_type>& left,
+    const ds::matrix<value_type>& right
+  )
+  {
+    ds::matrix<value_type> result(left.get_rows(), right.get_cols());
+    for(size_t row = 0; row < left.get_rows(); ++row)
+    {
+      for(size_t col = 0; col < right.get_cols(); ++col)
+      {
+        value_type sum = 0;
+        for(size_t i = 0; i < left.get_cols(); ++i)
+          sum += left.get(row, i) * right.get(i, col);
+        result.set(row, col, sum);
+      }
+    }
+
+    return result;
+  }
+
+} // namespace hlp
+
+TEST(DsMatrixTest, InvalidDimensionsThrow)
+{
+  EXPECT_THROW(ds::matrix<int> m(0, 3), std::out_of_range);
+  EXPECT_THROW(ds::matrix<int> m(3, 0), std::out_of_range);
+  EXPECT_THROW(
+    ds::matrix<int> m(3, 4, ds::matrix_layout::row_major, 3),
+    std::out_of_range
+  );
+  EXPECT_THROW(
+    ds::matrix<int> m(3, 4, ds::matrix_layout::column_major, 2),
+    std::out_of_range
+  );
+}
+
+TEST(DsMatrixTest, GetSetThrowsOutOfRange)
+{
+  ds::matrix<int> m(2, 3);
+
+  EXPECT_THROW(m.get(2, 0), std::out_of_range);
+  EXPECT_THROW(m.get(0, 3), std::out_of_range);
+  EXPECT_THROW(m.set(2, 0, 1), std::out_of_range);
+  EXPECT_THROW(m.set(0, 3, 1), std::out_of_range);
+  EXPECT_THROW(m.view(1, 1, 2, 1), std::out_of_range);
+  EXPECT_THROW(m.view(0, 2, 1, 2), std::out_of_range);
+}
+
+TEST(DsMatrixTest, Layouts)
+{
+  ds::matrix<int> row_major(2, 3);
+  ds::matrix<int> col_major(2, 3, ds::matrix_layout::column_major);
+  ds::matrix<int> padded(2, 3, ds::matrix_layout::row_major, 8);
+
+  hlp::fill_sequence(row_major, 0);
+  hlp::fill_sequence(col_major, 0);
+  hlp::fill_sequence(padded, 0);
+
+  EXPECT_EQ(row_major, col_major);
+  EXPECT_EQ(row_major, padded);
+
+  EXPECT_EQ(row_major.get(1, 0), row_major.raw_data()[3]);
+  EXPECT_EQ(col_major.get(1, 0), col_major.raw_data()[1]);
+  EXPECT_EQ(padded.get(1, 0), padded.raw_data()[8]);
+
+  EXPECT_EQ(3, row_major.get_leading_dimension());
+  EXPECT_EQ(2, col_major.get_leading_dimension());
+  EXPECT_EQ(8, padded.get_leading_dimension());
+
+  col_major.set(1, 2, 100);
+  EXPECT_NE(row_major, col_major);
+}
+
+TEST(DsMatrixTest, Views)
+{
+  ds::matrix<int> m(4, 5);
+  hlp::fill_sequence(m, 0);
+
+  ds::matrix_view<int> sub = m.view(1, 2, 3, 2);
+  EXPECT_EQ(3, sub.get_rows());
+  EXPECT_EQ(2, sub.get_cols());
+  EXPECT_EQ(m.get(1, 2), sub.get(0, 0));
+  EXPECT_EQ(m.get(3, 3), sub.get(2, 1));
+
+  // writes through the view
+  sub.set(2, 1, 42);
+  EXPECT_EQ(42, m.get(3, 3));
+
+  ds::matrix_view<const int> transposed = m.view().transposed();
+  EXPECT_EQ(5, transposed.get_rows());
+  EXPECT_EQ(4, transposed.get_cols());
+  EXPECT_EQ(m.get(3, 1), transposed.get(1, 3));
+
+  // a view of a view
+  EXPECT_EQ(m.get(2, 3), sub.view(1, 1, 1, 1).get(0, 0));
+}
+
+TEST(DsMatrixTest, MultipliesRectangularMatrices)
+{
+  const ds::matrix_layout layouts[] = {
+    ds::matrix_layout::row_major,
+    ds::matrix_layout::column_major
+  };
+
+  for(auto left_layout : layouts)
+  {
+    for(auto right_layout : layouts)
+    {
+      ds::matrix<long> left(37, 70, left_layout);
+      ds::matrix<long> right(70, 13, right_layout);
+      hlp::fill_sequence(left, 1);
+      hlp::fill_sequence(right, 2);
+
+      EXPECT_EQ(hlp::naive_multiply(left, right), left * right);
+    }
+  }
+
+  ds::matrix<int> m1(2, 3);
+  ds::matrix<int> m2(2, 3);
+  EXPECT_THROW(m1 * m2, std::out_of_range);
+}
+
+TEST(DsMatrixTest, MultiplyAddOnViews)
+{
+  ds::matrix<int> left(6, 6);
+  ds::matrix<int> right(6, 6);
+  hlp::fill_sequence(left, 3);
+  hlp::fill_sequence(right, 4);
+
+  // out = left(0..3, 1..5) * right^T(1..5, 2..3) + 1
+  ds::matrix<int> out(3, 2, ds::matrix_layout::column_major);
+  for(size_t row = 0; row < 3; ++row)
+    for(size_t col = 0; col < 2; ++col)
+      out.set(row, col, 1);
+
+  ds::multiply_add<int>(
+    left.view(0, 1, 3, 4),
+    right.view().transposed().view(1, 2, 4, 2),
+    out.view()
+  );
+
+  for(size_t row = 0; row < 3; ++row)
+  {
+    for(size_t col = 0; col < 2; ++col)
+    {
+      int expected = 1;
+      for(size_t i = 0; i < 4; ++i)
+        expected += left.get(row, 1 + i) * right.get(2 + col, 1 + i);
+      EXPECT_EQ(expected, out.get(row, col));
+    }
+  }
+
+  EXPECT_THROW(
+    ds::multiply_add<int>(left.view(), right.view(), out.view()),
+    std::out_of_range
+  );
+}
+
+TEST(DsMatrixTest, MultipliesVector)
+{
+  // row counts around the 4-row and 4-column steps of the kernel
+  const size_t shapes[][2] = { { 1, 1 }, { 3, 5 }, { 4, 4 }, { 9, 7 } };
+
+  for(const auto& shape : shapes)
+  {
+    const size_t rows = shape[0];
+    const size_t cols = shape[1];
+
+    std::vector<long> x(cols);
+    for(size_t i = 0; i < cols; ++i)
+      x[i] = static_cast<long>(i) - 2;
+
+    const ds::matrix<long> layouts[] = {
+      ds::matrix<long>(rows, cols),
+      ds::matrix<long>(rows, cols, ds::matrix_layout::column_major),
+      ds::matrix<long>(rows, cols, ds::matrix_layout::row_major, cols + 3)
+    };
+
+    for(auto m : layouts)
+    {
+      hlp::fill_sequence(m, 2);
+
+      std::vector<long> expected(rows, 0);
+      for(size_t row = 0; row < rows; ++row)
+        for(size_t col = 0; col < cols; ++col)
+          expected[row] += m.get(row, col) * x[col];
+
+      EXPECT_EQ(expected, m * x);
+    }
+  }
+
+  ds::matrix<int> m(2, 3);
+  EXPECT_THROW(m * std::vector<int>(2), std::out_of_range);
+}
+
+TEST(DsMatrixTest, Print)
+{
+  ds::matrix<int> m(2, 3, ds::matrix_layout::column_major);
+  hlp::fill_sequence(m, 8);
+
+  std::stringstream ss;
+  m.print(ss);
+
+  EXPECT_EQ("\n0\t1\t2\t\n3\t4\t5\t\n", ss.str());
+}
+
+
+}
+
@@ -0,0 +1,149 @@
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ds/matrix.h"
+#include "ds/sparse-matrix.h"
+#include "ds/square-matrix.h"
+
+namespace {
+
+namespace hlp {
+
+  // about one in seven elements is non-zero
+  inline ds::matrix<int> mostly_zeros(size_t rows, size_t cols, size_t seed)
+  {
+    ds::matrix<int> m(rows, cols);
+    for(size_t row = 0; row < rows; ++row)
+      for(size_t col = 0; col < cols; ++col)
+        if( (row * 31 + col * 17 + seed) % 7 == 0 )
+          m.set(row, col, static_cast<int>((row + col + seed) % 9) - 4);
+
+    return m;
+  }
+
+} // namespace hlp
+
+const ds::matrix_layout sparse_layouts[] = {
+  ds::matrix_layout::row_major,
+  ds::matrix_layout::column_major
+};
+
+TEST(DsSparseMatrixTest, ConvertsFromAndToDense)
+{
+  const ds::matrix<int> dense = hlp::mostly_zeros(13, 29, 1);
+
+  for(auto layout : sparse_layouts)
+  {
+    const ds::sparse_matrix<int> sparse(dense, layout);
+    EXPECT_EQ(13u, sparse.get_rows());
+    EXPECT_EQ(29u, sparse.get_cols());
+    EXPECT_EQ(dense, sparse.to_matrix());
+
+    size_t nonzeros = 0;
+    for(size_t row = 0; row < 13; ++row)
+    {
+      for(size_t col = 0; col < 29; ++col)
+      {
+        EXPECT_EQ(dense.get(row, col), sparse.get(row, col));
+        nonzeros += dense.get(row, col) != 0;
+      }
+    }
+    EXPECT_EQ(nonzeros, sparse.nonzeros());
+  }
+
+  ds::square_matrix<int> square(3);
+  square.set(0, 2, 5);
+  square.set(2, 1, -1);
+
+  const ds::sparse_matrix<int> sparse(square);
+  EXPECT_EQ(2u, sparse.nonzeros());
+  EXPECT_EQ(square, sparse.to_square_matrix());
+  EXPECT_THROW(
+    ds::sparse_matrix<int>(2, 3).to_square_matrix(), std::out_of_range
+  );
+}
+
+TEST(DsSparseMatrixTest, BuildsFromEntries)
+{
+  // unsorted, with a duplicate and an entry summing up to zero
+  const std::vector<ds::sparse_entry<int>> entries = {
+    { 2, 0, 4 }, { 0, 1, 1 }, { 2, 0, 3 }, { 1, 1, 2 }, { 1, 1, -2 }
+  };
+
+  for(auto layout : sparse_layouts)
+  {
+    const ds::sparse_matrix<int> sparse(3, 2, entries, layout);
+    EXPECT_EQ(2u, sparse.nonzeros());
+    EXPECT_EQ(7, sparse.get(2, 0));
+    EXPECT_EQ(1, sparse.get(0, 1));
+    EXPECT_EQ(0, sparse.get(1, 1));
+    EXPECT_THROW(sparse.get(3, 0), std::out_of_range);
+  }
+
+  const std::vector<ds::sparse_entry<int>> outside = { { 0, 2, 1 } };
+  EXPECT_THROW(ds::sparse_matrix<int>(3, 2, outside), std::out_of_range);
+}
+
+TEST(DsSparseMatrixTest, ChangesLayout)
+{
+  const ds::matrix<int> dense = hlp::mostly_zeros(17, 5, 2);
+  const ds::sparse_matrix<int> csr(dense);
+  const ds::sparse_matrix<int> csc(csr.with_layout(
+    ds::matrix_layout::column_major
+  ));
+
+  EXPECT_EQ(ds::matrix_layout::column_major, csc.get_layout());
+  EXPECT_EQ(dense, csc.to_matrix());
+  EXPECT_EQ(csr, csc);
+  EXPECT_EQ(csr, csc.with_layout(ds::matrix_layout::row_major));
+}
+
+TEST(DsSparseMatrixTest, MultipliesVector)
+{
+  const ds::matrix<int> dense = hlp::mostly_zeros(21, 11, 3);
+
+  std::vector<int> x(11);
+  for(size_t i = 0; i < x.size(); ++i)
+    x[i] = static_cast<int>(i) - 5;
+
+  std::vector<int> expected(21, 0);
+  for(size_t row = 0; row < 21; ++row)
+    for(size_t col = 0; col < 11; ++col)
+      expected[row] += dense.get(row, col) * x[col];
+
+  for(auto layout : sparse_layouts)
+  {
+    const ds::sparse_matrix<int> sparse(dense, layout);
+    EXPECT_EQ(expected, sparse * x);
+    EXPECT_THROW(sparse * std::vector<int>(10), std::out_of_range);
+  }
+}
+
+TEST(DsSparseMatrixTest, MultipliesSparseMatrix)
+{
+  const ds::matrix<int> left = hlp::mostly_zeros(23, 40, 4);
+  const ds::matrix<int> right = hlp::mostly_zeros(40, 9, 5);
+  const ds::matrix<int> expected = left * right;
+
+  for(auto left_layout : sparse_layouts)
+  {
+    for(auto right_layout : sparse_layouts)
+    {
+      const ds::sparse_matrix<int> product =
+        ds::sparse_matrix<int>(left, left_layout) *
+        ds::sparse_matrix<int>(right, right_layout);
+
+      EXPECT_EQ(left_layout, product.get_layout());
+      EXPECT_EQ(expected, product.to_matrix());
+      EXPECT_EQ(ds::sparse_matrix<int>(expected), product);
+    }
+  }
+
+  EXPECT_THROW(
+    ds::sparse_matrix<int>(left) * ds::sparse_matrix<int>(left),
+    std::out_of_range
+  );
+}
+
+}
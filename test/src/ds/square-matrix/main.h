@@ -1,6 +1,7 @@
 #include <sstream>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "ds/square-matrix.h"
@@ -149,6 +150,119 @@ TEST(DsSquareMatrixTest, MatrixSubtraction)
   EXPECT_EQ(2, m3.get_width());
 }
 
+TEST(DsSquareMatrixTest, ChainedExpression)
+{
+  std::array<ds::square_matrix<int>, 4> ms {{
+    ds::square_matrix<int>(3),
+    ds::square_matrix<int>(3),
+    ds::square_matrix<int>(3),
+    ds::square_matrix<int>(3)
+  }};
+
+  ds::square_matrix<int> expected(3);
+  for(size_t row = 0; row < 3; ++row)
+  {
+    for(size_t col = 0; col < 3; ++col)
+    {
+      const int val = static_cast<int>(row * 3 + col);
+      ms[0].set(row, col, val);
+      ms[1].set(row, col, val * 2);
+      ms[2].set(row, col, -val);
+      ms[3].set(row, col, 7);
+      expected.set(row, col, val + val * 2 + val + 7);
+    }
+  }
+
+  ds::square_matrix<int> result(ms[0] + ms[1] - ms[2] + ms[3]);
+  EXPECT_EQ(expected, result);
+
+  // nested expressions on the right hand side
+  ds::square_matrix<int> nested(ms[0] + (ms[1] - (ms[2] - ms[3])));
+  EXPECT_EQ(expected, nested);
+
+  // assign an expression that reads the assigned-to matrix
+  result = result - ms[0] - ms[1] + ms[2] - ms[3];
+  EXPECT_EQ(ds::square_matrix<int>(3), result);
+}
+
+TEST(DsSquareMatrixTest, MultipliesAndComparesExpressions)
+{
+  ds::square_matrix<int> a(2), b(2), c(2);
+  for(size_t row = 0; row < 2; ++row)
+  {
+    for(size_t col = 0; col < 2; ++col)
+    {
+      const int val = static_cast<int>(row * 2 + col);
+      a.set(row, col, val);
+      b.set(row, col, 1 - val);
+      c.set(row, col, val * val);
+    }
+  }
+
+  const ds::square_matrix<int> sum(a + b);
+  const ds::square_matrix<int> difference(a - c);
+
+  EXPECT_EQ(sum * c, (a + b) * c);
+  EXPECT_EQ(c * sum, c * (a + b));
+  EXPECT_EQ(sum * difference, (a + b) * (a - c));
+  EXPECT_EQ(sum * difference * c, (a + b) * (a - c) * c);
+
+  EXPECT_TRUE((a + b) == sum);
+  EXPECT_TRUE(sum == a + b);
+  EXPECT_TRUE((a + b) == (b + a));
+  EXPECT_TRUE((a + b) != c);
+  EXPECT_FALSE((a - c) != difference);
+  EXPECT_FALSE(c == a - c);
+}
+
+TEST(DsSquareMatrixTest, MultipliesVector)
+{
+  ds::square_matrix<int> m(2);
+  m.set(0, 0, 1);
+  m.set(0, 1, 2);
+  m.set(1, 0, 3);
+  m.set(1, 1, 4);
+
+  EXPECT_EQ(std::vector<int>({ 5, 11 }), m * std::vector<int>({ 1, 2 }));
+  EXPECT_THROW(m * std::vector<int>(3), std::out_of_range);
+}
+
+TEST(DsSquareMatrixTest, VectorizedSumDifferenceAndScale)
+{
+  const size_t width = 37;
+  ds::square_matrix<double> left(width), right(width);
+  ds::square_matrix<double> sum(width), difference(width), scaled(width);
+  for(size_t row = 0; row < width; ++row)
+  {
+    for(size_t col = 0; col < width; ++col)
+    {
+      const double l = static_cast<double>(row) - static_cast<double>(col);
+      const double r = static_cast<double>(row * col);
+      left.set(row, col, l);
+      right.set(row, col, r);
+      sum.set(row, col, l + r);
+      difference.set(row, col, l - r);
+      scaled.set(row, col, l * -3.0);
+    }
+  }
+
+  EXPECT_EQ(sum, ds::square_matrix<double>(left + right));
+  EXPECT_EQ(difference, ds::square_matrix<double>(left - right));
+
+  left *= -3.0;
+  EXPECT_EQ(scaled, left);
+}
+
+TEST(DsSquareMatrixTest, ExpressionThrowsOutOfRange)
+{
+  ds::square_matrix<int> m2(2);
+  ds::square_matrix<int> m3(3);
+
+  EXPECT_THROW(m2 + m3, std::out_of_range);
+  EXPECT_THROW(m2 - m3, std::out_of_range);
+  EXPECT_THROW((m2 + m2) - m3, std::out_of_range);
+}
+
 TEST(DsSquareMatrixTest, Copy)
 {
   ds::square_matrix<int> m(2);
@@ -3,19 +3,41 @@
 #include "al/mergesort/main.h"
 #include "al/sort-and-count-inversions/main.h"
 #include "al/strassen-matrix-multiply/main.h"
+#include "al/blocked-matrix-multiply/main.h"
+#include "al/small-matrix-multiply/main.h"
+#include "al/parallel-strassen-matrix-multiply/main.h"
+#include "al/winograd-matrix-multiply/main.h"
+#include "al/matrix-multiply-policy/main.h"
+#include "al/elementwise/main.h"
+#include "al/modular-matrix-multiply/main.h"
+#include "al/matrix-power/main.h"
+#include "al/matrix-chain-multiply/main.h"
+#include "al/parallel-sparse-matrix-multiply/main.h"
 #include "al/radixsort/main.h"
 #include "al/murmur/main.h"
 #include "al/counting-sort/main.h"
 #include "al/boyer-moore/main.h"
+#include "al/stream-searcher/main.h"
+#include "al/parallel-grep/main.h"
+#include "al/simd-substring/main.h"
+#include "al/aho-corasick/main.h"
+#include "al/substring-search/main.h"
 
 #include "ds/stack/main.h"
 #include "ds/square-matrix/main.h"
+#include "ds/boolean-square-matrix/main.h"
+#include "ds/matrix/main.h"
+#include "ds/sparse-matrix/main.h"
 #include "ds/binary-search-tree/main.h"
 #include "ds/fixed-hashtable/main.h"
 #include "ds/priority-queue/main.h"
 #include "ds/bloom-filter/main.h"
 #include "ds/infix-ostream-iterator/main.h"
 
+#include "util/thread-pool/main.h"
+#include "util/aligned-allocator/main.h"
+#include "util/mapped-file/main.h"
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,57 @@
+#ifndef SUPPORT_HELPERS_H
+#define SUPPORT_HELPERS_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace support {
+
+// offsets of every occurrence of pattern in text, overlapping ones
+// included, by std::string::find; the reference for the substring searchers
+inline std::vector<uint64_t> find_all_offsets(
+  const std::string& pattern,
+  const std::string& text
+)
+{
+  std::vector<uint64_t> offsets;
+  for(size_t pos = text.find(pattern);
+      pos != std::string::npos;
+      pos = text.find(pattern, pos + 1))
+    offsets.push_back(pos);
+
+  return offsets;
+}
+
+// pointers into text to every occurrence of pattern, see find_all_offsets
+inline std::vector<const char *> find_all_pointers(
+  const std::string& pattern,
+  const std::string& text
+)
+{
+  std::vector<const char *> matches;
+  for(auto offset : find_all_offsets(pattern, text))
+    matches.push_back(text.data() + offset);
+
+  return matches;
+}
+
+// the path of a new, empty file under /tmp, for the caller to remove
+inline std::string temp_file_path()
+{
+  char path[] = "/tmp/datas-and-algos-test-XXXXXX";
+  const int fd = mkstemp(path);
+  if( fd < 0 )
+    throw std::runtime_error("cannot create a temporary file");
+
+  close(fd);
+  return path;
+}
+
+}
+
+#endif // SUPPORT_HELPERS_H
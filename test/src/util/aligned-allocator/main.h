@@ -0,0 +1,39 @@
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "util/aligned-allocator.h"
+
+namespace {
+
+TEST(UtilAlignedAllocatorTest, ReturnsAlignedMemory)
+{
+  for(size_t num = 1; num < 100; ++num)
+  {
+    std::vector<char, util::aligned_allocator<char>> bytes(num, 'x');
+    std::vector<double, util::aligned_allocator<double, 32>> doubles(num, 1.0);
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(bytes.data()) % 64);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(doubles.data()) % 32);
+    EXPECT_EQ(num, bytes.size());
+    EXPECT_EQ(1.0, doubles.back());
+  }
+}
+
+TEST(UtilAlignedAllocatorTest, GrowsLikeAStdVector)
+{
+  std::vector<int, util::aligned_allocator<int>> v;
+  for(int i = 0; i < 1000; ++i)
+  {
+    v.push_back(i);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(v.data()) % 64);
+  }
+
+  for(int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, v[static_cast<size_t>(i)]);
+
+  EXPECT_TRUE(util::aligned_allocator<int>() == util::aligned_allocator<long>());
+  EXPECT_FALSE(util::aligned_allocator<int>() != util::aligned_allocator<long>());
+}
+
+}
@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "util/mapped-file.h"
+
+#include "support/helpers.h"
+
+namespace {
+
+TEST(UtilMappedFileTest, MapsContents)
+{
+  const std::string path = support::temp_file_path();
+  std::string contents;
+  for(int i = 0; i < 10000; ++i)
+    contents += "line " + std::to_string(i) + "\n";
+
+  {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out << contents;
+  }
+
+  const util::mapped_file file(path);
+  ASSERT_EQ(contents.size(), file.size());
+  EXPECT_EQ(contents, std::string(file.data(), file.size()));
+
+  std::remove(path.c_str());
+}
+
+TEST(UtilMappedFileTest, EmptyFile)
+{
+  const std::string path = support::temp_file_path();
+  const util::mapped_file file(path);
+  EXPECT_EQ(0u, file.size());
+
+  std::remove(path.c_str());
+}
+
+TEST(UtilMappedFileTest, ThrowsOnMissingFile)
+{
+  const std::string path = support::temp_file_path();
+  std::remove(path.c_str());
+
+  EXPECT_THROW(util::mapped_file{path}, std::runtime_error);
+}
+
+}
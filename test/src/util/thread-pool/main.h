@@ -0,0 +1,82 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "util/thread-pool.h"
+
+namespace {
+
+TEST(UtilThreadPoolTest, RunsAllTasks)
+{
+  util::thread_pool pool(4);
+  std::atomic<int> counter(0);
+
+  std::vector<std::future<int>> results;
+  for(int i = 0; i < 1000; ++i)
+  {
+    results.push_back(pool.submit([&counter, i]() {
+      ++counter;
+      return i * 2;
+    }));
+  }
+
+  for(int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i * 2, results[static_cast<size_t>(i)].get());
+
+  EXPECT_EQ(1000, counter.load());
+}
+
+// every task waits for tasks it spawned itself; with blocking waits this
+// would deadlock a pool with fewer threads than nesting levels
+int nested_sum(util::thread_pool& pool, int depth)
+{
+  if( depth == 0 )
+    return 1;
+
+  std::future<int> left = pool.submit([&pool, depth]() {
+    return nested_sum(pool, depth - 1);
+  });
+  std::future<int> right = pool.submit([&pool, depth]() {
+    return nested_sum(pool, depth - 1);
+  });
+
+  pool.wait(left);
+  pool.wait(right);
+
+  return left.get() + right.get();
+}
+
+TEST(UtilThreadPoolTest, NestedTasksDoNotDeadlock)
+{
+  util::thread_pool pool(2);
+  EXPECT_EQ(1 << 8, nested_sum(pool, 8));
+}
+
+TEST(UtilThreadPoolTest, PropagatesExceptions)
+{
+  util::thread_pool pool(2);
+  std::future<void> result = pool.submit([]() {
+    throw std::runtime_error("task failed");
+  });
+
+  pool.wait(result);
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(UtilThreadPoolTest, FinishesQueuedTasksOnDestruction)
+{
+  std::atomic<int> counter(0);
+  {
+    util::thread_pool pool(1);
+    for(int i = 0; i < 100; ++i)
+      pool.submit([&counter]() { ++counter; });
+  }
+
+  EXPECT_EQ(100, counter.load());
+}
+
+
+}
+